@@ -154,6 +154,12 @@ bool JSCallbackObject<Base>::getOwnPropertySlot(ExecState* exec, const Identifie
         
         if (OpaqueJSClassStaticFunctionsTable* staticFunctions = jsClass->staticFunctions(exec)) {
             if (staticFunctions->contains(propertyName.ustring().rep())) {
+                /* FYWEBKITMOD BEGIN */
+                // Once staticFunctionGetter() has cached the function object, hand it
+                // out directly instead of going through the getter on every call.
+                if (Base::getOwnPropertySlot(exec, propertyName, slot))
+                    return true;
+                /* FYWEBKITMOD END */
                 slot.setCustom(this, staticFunctionGetter);
                 return true;
             }
@@ -322,6 +322,12 @@ void CodeBlock::printStructures(const Instruction* vPC) const
         printStructure("resolve_global_dynamic", vPC, 4);
         return;
     }
+    /* FYWEBKITMOD BEGIN */
+    if (vPC[0].u.opcode == interpreter->getOpcode(op_new_object_literal)) {
+        printStructure("new_object_literal", vPC, 2);
+        return;
+    }
+    /* FYWEBKITMOD END */
 
     // These m_instructions doesn't ref Structures.
     ASSERT(vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_generic) || vPC[0].u.opcode == interpreter->getOpcode(op_put_by_id_generic) || vPC[0].u.opcode == interpreter->getOpcode(op_call) || vPC[0].u.opcode == interpreter->getOpcode(op_call_eval) || vPC[0].u.opcode == interpreter->getOpcode(op_construct));
@@ -501,6 +507,22 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
             printf("[%4d] create_arguments\t %s\n", location, registerName(exec, r0).data());
             break;
         }
+        /* FYWEBKITMOD BEGIN */
+        case op_get_arguments_length: {
+            int r0 = (++it)->u.operand;
+            int r1 = (++it)->u.operand;
+            int id0 = (++it)->u.operand;
+            printf("[%4d] get_arguments_length\t %s, %s, %s\n", location, registerName(exec, r0).data(), registerName(exec, r1).data(), idName(id0, m_identifiers[id0]).data());
+            break;
+        }
+        case op_get_argument_by_val: {
+            int r0 = (++it)->u.operand;
+            int r1 = (++it)->u.operand;
+            int r2 = (++it)->u.operand;
+            printf("[%4d] get_argument_by_val\t %s, %s, %s\n", location, registerName(exec, r0).data(), registerName(exec, r1).data(), registerName(exec, r2).data());
+            break;
+        }
+        /* FYWEBKITMOD END */
         case op_init_arguments: {
             int r0 = (++it)->u.operand;
             printf("[%4d] init_arguments\t %s\n", location, registerName(exec, r0).data());
@@ -517,6 +539,13 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
             printf("[%4d] create_this %s %s\n", location, registerName(exec, r0).data(), registerName(exec, r1).data());
             break;
         }
+        /* FYWEBKITMOD BEGIN */
+        case op_record_this_size: {
+            int r0 = (++it)->u.operand;
+            printf("[%4d] record_this_size %s\n", location, registerName(exec, r0).data());
+            break;
+        }
+        /* FYWEBKITMOD END */
         case op_convert_this: {
             int r0 = (++it)->u.operand;
             printf("[%4d] convert_this %s\n", location, registerName(exec, r0).data());
@@ -527,6 +556,20 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
             printf("[%4d] new_object\t %s\n", location, registerName(exec, r0).data());
             break;
         }
+        /* FYWEBKITMOD BEGIN */
+        case op_new_object_literal: {
+            int r0 = (++it)->u.operand;
+            printf("[%4d] new_object_literal\t %s\n", location, registerName(exec, r0).data());
+            it++;
+            break;
+        }
+        case op_end_object_literal: {
+            int r0 = (++it)->u.operand;
+            int newObject = (++it)->u.operand;
+            printf("[%4d] end_object_literal\t %s, [%4d]\n", location, registerName(exec, r0).data(), newObject);
+            break;
+        }
+        /* FYWEBKITMOD END */
         case op_new_array: {
             int dst = (++it)->u.operand;
             int argv = (++it)->u.operand;
@@ -1468,6 +1511,13 @@ void CodeBlock::derefStructures(Instruction* vPC) const
             vPC[4].u.structure->deref();
         return;
     }
+    /* FYWEBKITMOD BEGIN */
+    if (vPC[0].u.opcode == interpreter->getOpcode(op_new_object_literal)) {
+        if (vPC[2].u.structure)
+            vPC[2].u.structure->deref();
+        return;
+    }
+    /* FYWEBKITMOD END */
     if ((vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_proto_list))
         || (vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_self_list))
         || (vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_getter_proto_list))
@@ -43,11 +43,16 @@ namespace JSC {
         macro(op_enter_with_activation, 2) \
         macro(op_init_arguments, 2) \
         macro(op_create_arguments, 2) \
+        macro(op_get_arguments_length, 4) /* FYWEBKITMOD */ \
+        macro(op_get_argument_by_val, 4) /* FYWEBKITMOD */ \
         macro(op_create_this, 3) \
+        macro(op_record_this_size, 2) /* FYWEBKITMOD */ \
         macro(op_get_callee, 2) \
         macro(op_convert_this, 2) \
         \
         macro(op_new_object, 2) \
+        macro(op_new_object_literal, 3) /* FYWEBKITMOD */ \
+        macro(op_end_object_literal, 3) /* FYWEBKITMOD */ \
         macro(op_new_array, 4) \
         macro(op_new_regexp, 3) \
         macro(op_mov, 3) \
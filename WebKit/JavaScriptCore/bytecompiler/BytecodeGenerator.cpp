@@ -1354,6 +1354,31 @@ RegisterID* BytecodeGenerator::emitGetByVal(RegisterID* dst, RegisterID* base, R
     return dst;
 }
 
+/* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+// arguments.length and arguments[i] only read the arguments register. Unlike registerFor(),
+// they don't create the Arguments object up front; the interpreter reads the call frame for
+// as long as the register is still empty. The JIT has no implementation of these opcodes.
+RegisterID* BytecodeGenerator::emitGetArgumentsLength(RegisterID* dst, const Identifier& length)
+{
+    emitOpcode(op_get_arguments_length);
+    instructions().append(dst->index());
+    instructions().append(uncheckedRegisterForArguments()->index());
+    instructions().append(addConstant(length));
+    return dst;
+}
+
+RegisterID* BytecodeGenerator::emitGetArgumentByVal(RegisterID* dst, RegisterID* property)
+{
+    emitOpcode(op_get_argument_by_val);
+    instructions().append(dst->index());
+    instructions().append(uncheckedRegisterForArguments()->index());
+    instructions().append(property->index());
+    return dst;
+}
+#endif
+/* FYWEBKITMOD END */
+
 RegisterID* BytecodeGenerator::emitPutByVal(RegisterID* base, RegisterID* property, RegisterID* value)
 {
     emitOpcode(op_put_by_val);
@@ -1388,6 +1413,29 @@ RegisterID* BytecodeGenerator::emitNewObject(RegisterID* dst)
     return dst;
 }
 
+/* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+// new_object_literal creates the object with the structure end_object_literal recorded for
+// the first object made by the same literal. The JIT has no implementation of these opcodes.
+RegisterID* BytecodeGenerator::emitNewObjectLiteral(RegisterID* dst, unsigned& newObjectOffset)
+{
+    newObjectOffset = instructions().size();
+    m_codeBlock->addPropertyAccessInstruction(newObjectOffset);
+    emitOpcode(op_new_object_literal);
+    instructions().append(dst->index());
+    instructions().append(0);
+    return dst;
+}
+
+void BytecodeGenerator::emitEndObjectLiteral(RegisterID* object, unsigned newObjectOffset)
+{
+    emitOpcode(op_end_object_literal);
+    instructions().append(object->index());
+    instructions().append(newObjectOffset);
+}
+#endif
+/* FYWEBKITMOD END */
+
 RegisterID* BytecodeGenerator::emitNewArray(RegisterID* dst, ElementNode* elements)
 {
     Vector<RefPtr<RegisterID>, 16> argv;
@@ -1558,6 +1606,17 @@ RegisterID* BytecodeGenerator::emitReturn(RegisterID* src)
         instructions().append(m_codeBlock->argumentsRegister());
     }
 
+    /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+    // Lets the function learn how many properties the objects it constructs get, see
+    // FunctionExecutable::constructedPropertyCount().
+    if (isConstructor()) {
+        emitOpcode(op_record_this_size);
+        instructions().append(m_thisRegister.index());
+    }
+#endif
+    /* FYWEBKITMOD END */
+
     // Constructors use op_ret_object_or_this to check the result is an
     // object, unless we can trivially determine the check is not
     // necessary (currently, if the return value is 'this').
@@ -309,6 +309,12 @@ namespace JSC {
         RegisterID* emitUnaryNoDstOp(OpcodeID, RegisterID* src);
 
         RegisterID* emitNewObject(RegisterID* dst);
+        /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+        RegisterID* emitNewObjectLiteral(RegisterID* dst, unsigned& newObjectOffset);
+        void emitEndObjectLiteral(RegisterID* object, unsigned newObjectOffset);
+#endif
+        /* FYWEBKITMOD END */
         RegisterID* emitNewArray(RegisterID* dst, ElementNode*); // stops at first elision
 
         RegisterID* emitNewFunction(RegisterID* dst, FunctionBodyNode* body);
@@ -341,6 +347,12 @@ namespace JSC {
         RegisterID* emitDirectPutById(RegisterID* base, const Identifier& property, RegisterID* value);
         RegisterID* emitDeleteById(RegisterID* dst, RegisterID* base, const Identifier&);
         RegisterID* emitGetByVal(RegisterID* dst, RegisterID* base, RegisterID* property);
+        /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+        RegisterID* emitGetArgumentsLength(RegisterID* dst, const Identifier& length);
+        RegisterID* emitGetArgumentByVal(RegisterID* dst, RegisterID* property);
+#endif
+        /* FYWEBKITMOD END */
         RegisterID* emitPutByVal(RegisterID* base, RegisterID* property, RegisterID* value);
         RegisterID* emitDeleteByVal(RegisterID* dst, RegisterID* base, RegisterID* property);
         RegisterID* emitPutByIndex(RegisterID* base, unsigned index, RegisterID* value);
@@ -259,6 +259,23 @@ RegisterID* PropertyListNode::emitBytecode(BytecodeGenerator& generator, Registe
 {
     RefPtr<RegisterID> newObj = generator.tempDestination(dst);
     
+    /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+    // Literals of plain named properties start out with all of them, as the objects made by
+    // the literal before, and their puts only replace values.
+    bool isPlainLiteral = true;
+    for (PropertyListNode* p = this; p; p = p->m_next) {
+        if (p->m_node->m_type != PropertyNode::Constant || p->m_node->name() == generator.globalData()->propertyNames->underscoreProto) {
+            isPlainLiteral = false;
+            break;
+        }
+    }
+    unsigned newObjectOffset = 0;
+    if (isPlainLiteral)
+        generator.emitNewObjectLiteral(newObj.get(), newObjectOffset);
+    else
+#endif
+    /* FYWEBKITMOD END */
     generator.emitNewObject(newObj.get());
     
     for (PropertyListNode* p = this; p; p = p->m_next) {
@@ -282,6 +299,13 @@ RegisterID* PropertyListNode::emitBytecode(BytecodeGenerator& generator, Registe
         }
     }
     
+    /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+    if (isPlainLiteral)
+        generator.emitEndObjectLiteral(newObj.get(), newObjectOffset);
+#endif
+    /* FYWEBKITMOD END */
+
     return generator.moveToDestinationIfNeeded(dst, newObj.get());
 }
 
@@ -289,6 +313,15 @@ RegisterID* PropertyListNode::emitBytecode(BytecodeGenerator& generator, Registe
 
 RegisterID* BracketAccessorNode::emitBytecode(BytecodeGenerator& generator, RegisterID* dst)
 {
+    /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+    if (!m_subscriptHasAssignments && m_base->isResolveNode() && generator.willResolveToArguments(static_cast<ResolveNode*>(m_base)->identifier())) {
+        RegisterID* property = generator.emitNode(m_subscript);
+        generator.emitExpressionInfo(divot(), startOffset(), endOffset());
+        return generator.emitGetArgumentByVal(generator.finalDestination(dst), property);
+    }
+#endif
+    /* FYWEBKITMOD END */
     RefPtr<RegisterID> base = generator.emitNodeForLeftHandSide(m_base, m_subscriptHasAssignments, m_subscript->isPure(generator));
     RegisterID* property = generator.emitNode(m_subscript);
     generator.emitExpressionInfo(divot(), startOffset(), endOffset());
@@ -299,6 +332,14 @@ RegisterID* BracketAccessorNode::emitBytecode(BytecodeGenerator& generator, Regi
 
 RegisterID* DotAccessorNode::emitBytecode(BytecodeGenerator& generator, RegisterID* dst)
 {
+    /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+    if (m_ident == generator.propertyNames().length && m_base->isResolveNode() && generator.willResolveToArguments(static_cast<ResolveNode*>(m_base)->identifier())) {
+        generator.emitExpressionInfo(divot(), startOffset(), endOffset());
+        return generator.emitGetArgumentsLength(generator.finalDestination(dst), m_ident);
+    }
+#endif
+    /* FYWEBKITMOD END */
     RegisterID* base = generator.emitNode(m_base);
     generator.emitExpressionInfo(divot(), startOffset(), endOffset());
     return generator.emitGetById(generator.finalDestination(dst), base, m_ident);
@@ -337,6 +337,87 @@ ALWAYS_INLINE CallFrame* Interpreter::slideRegisterWindowForCall(CodeBlock* newC
 }
 
 #if ENABLE(INTERPRETER)
+/* FYWEBKITMOD BEGIN */
+// Element access for typed array wrappers registered with JSGlobalData::registerTypedArrayDescriptor().
+
+static ALWAYS_INLINE char* typedArrayImpl(JSCell* cell, const TypedArrayDescriptor* descriptor)
+{
+    return *reinterpret_cast<char**>(reinterpret_cast<char*>(cell) + descriptor->m_implOffset);
+}
+
+template <typename T> static ALWAYS_INLINE T* typedArrayElements(JSCell* cell, const TypedArrayDescriptor* descriptor)
+{
+    return *reinterpret_cast<T**>(typedArrayImpl(cell, descriptor) + descriptor->m_storageOffset);
+}
+
+// The descriptor of value if it is a typed array and i is in range.
+static ALWAYS_INLINE const TypedArrayDescriptor* typedArrayDescriptorForIndex(JSGlobalData* globalData, JSValue value, unsigned i)
+{
+    if (!globalData->typedArrayDescriptorCount || !value.isCell())
+        return 0;
+    JSCell* cell = value.asCell();
+    const TypedArrayDescriptor* descriptor = globalData->typedArrayDescriptor(cell->vptr());
+    if (!descriptor || i >= *reinterpret_cast<unsigned*>(typedArrayImpl(cell, descriptor) + descriptor->m_lengthOffset))
+        return 0;
+    return descriptor;
+}
+
+static JSValue getTypedArrayElement(CallFrame* callFrame, JSCell* cell, const TypedArrayDescriptor* descriptor, unsigned i)
+{
+    switch (descriptor->m_type) {
+    case TypedArrayInt8:
+        return jsNumber(callFrame, static_cast<int>(typedArrayElements<signed char>(cell, descriptor)[i]));
+    case TypedArrayUint8:
+        return jsNumber(callFrame, static_cast<int>(typedArrayElements<unsigned char>(cell, descriptor)[i]));
+    case TypedArrayInt16:
+        return jsNumber(callFrame, static_cast<int>(typedArrayElements<short>(cell, descriptor)[i]));
+    case TypedArrayUint16:
+        return jsNumber(callFrame, static_cast<int>(typedArrayElements<unsigned short>(cell, descriptor)[i]));
+    case TypedArrayInt32:
+        return jsNumber(callFrame, typedArrayElements<int>(cell, descriptor)[i]);
+    case TypedArrayUint32:
+        return jsNumber(callFrame, typedArrayElements<unsigned>(cell, descriptor)[i]);
+    case TypedArrayFloat32:
+        return jsNumber(callFrame, static_cast<double>(typedArrayElements<float>(cell, descriptor)[i]));
+    case TypedArrayTypeCount:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return jsUndefined();
+}
+
+// Integers wrap around like the bindings' index setters do, see JSUint8Array::indexSetter().
+static void putTypedArrayElement(JSCell* cell, const TypedArrayDescriptor* descriptor, unsigned i, double value)
+{
+    switch (descriptor->m_type) {
+    case TypedArrayInt8:
+        typedArrayElements<signed char>(cell, descriptor)[i] = static_cast<signed char>(toInt32(value));
+        return;
+    case TypedArrayUint8:
+        typedArrayElements<unsigned char>(cell, descriptor)[i] = static_cast<unsigned char>(toInt32(value));
+        return;
+    case TypedArrayInt16:
+        typedArrayElements<short>(cell, descriptor)[i] = static_cast<short>(toInt32(value));
+        return;
+    case TypedArrayUint16:
+        typedArrayElements<unsigned short>(cell, descriptor)[i] = static_cast<unsigned short>(toInt32(value));
+        return;
+    case TypedArrayInt32:
+        typedArrayElements<int>(cell, descriptor)[i] = toInt32(value);
+        return;
+    case TypedArrayUint32:
+        typedArrayElements<unsigned>(cell, descriptor)[i] = static_cast<unsigned>(toInt32(value));
+        return;
+    case TypedArrayFloat32:
+        typedArrayElements<float>(cell, descriptor)[i] = static_cast<float>(value);
+        return;
+    case TypedArrayTypeCount:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+}
+/* FYWEBKITMOD END */
+
 static NEVER_INLINE bool isInvalidParamForIn(CallFrame* callFrame, CodeBlock* codeBlock, const Instruction* vPC, JSValue value, JSValue& exceptionData)
 {
     if (value.isObject())
@@ -383,9 +464,10 @@ NEVER_INLINE JSValue Interpreter::callEval(CallFrame* callFrame, RegisterFile* r
     return result;
 }
 
-Interpreter::Interpreter()
+Interpreter::Interpreter(size_t registerFileCapacity) // FYWEBKITMOD
     : m_sampleEntryDepth(0)
     , m_reentryDepth(0)
+    , m_registerFile(registerFileCapacity) // FYWEBKITMOD
 {
 #if ENABLE(COMPUTED_GOTO_INTERPRETER)
     privateExecute(InitializeAndReturn, 0, 0, 0);
@@ -1476,6 +1558,51 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         vPC += OPCODE_LENGTH(op_new_object);
         NEXT_INSTRUCTION();
     }
+    /* FYWEBKITMOD BEGIN */
+    DEFINE_OPCODE(op_new_object_literal) {
+        /* new_object_literal dst(r) structure(sID)
+
+           Constructs a new Object instance for an object literal and puts
+           the result in register dst. Once end_object_literal has recorded
+           a structure, the object starts out with all of its properties,
+           set to undefined.
+        */
+        int dst = vPC[1].u.operand;
+        JSObject* object = constructEmptyObject(callFrame);
+        if (Structure* structure = vPC[2].u.structure)
+            object->transitionToLiteralStructure(structure);
+        callFrame->r(dst) = JSValue(object);
+
+        vPC += OPCODE_LENGTH(op_new_object_literal);
+        NEXT_INSTRUCTION();
+    }
+    DEFINE_OPCODE(op_end_object_literal) {
+        /* end_object_literal object(r) newObject(n)
+
+           Records the structure of the object made by an object literal
+           in the new_object_literal instruction at offset newObject, unless
+           one was recorded already. Dictionaries and objects whose
+           prototype changed are not recorded. The structure is shared with
+           the objects that got there by transitions; only literals with
+           function values get a copy without them.
+        */
+        Instruction* newObject = codeBlock->instructions().begin() + vPC[2].u.operand;
+        if (!newObject[2].u.structure) {
+            Structure* structure = asObject(callFrame->r(vPC[1].u.operand).jsValue())->structure();
+            if (!structure->isDictionary() && structure->storedPrototype() == callFrame->lexicalGlobalObject()->objectPrototype()) {
+                if (structure->hasSpecificFunctions())
+                    newObject[2].u.structure = Structure::despecifiedCopy(structure).releaseRef();
+                else {
+                    structure->ref();
+                    newObject[2].u.structure = structure;
+                }
+            }
+        }
+
+        vPC += OPCODE_LENGTH(op_end_object_literal);
+        NEXT_INSTRUCTION();
+    }
+    /* FYWEBKITMOD END */
     DEFINE_OPCODE(op_new_array) {
         /* new_array dst(r) firstArg(r) argCount(n)
 
@@ -3085,6 +3212,16 @@ skip_id_custom_self:
             vPC += OPCODE_LENGTH(op_get_by_pname);
             NEXT_INSTRUCTION();
         }
+        /* FYWEBKITMOD BEGIN */
+        if (subscript == expectedSubscript && index < static_cast<int>(it->indexedLength()) && isJSArray(globalData, baseValue)) {
+            JSArray* jsArray = asArray(baseValue);
+            if (jsArray->canGetIndex(index)) {
+                callFrame->r(dst) = jsArray->getIndex(index);
+                vPC += OPCODE_LENGTH(op_get_by_pname);
+                NEXT_INSTRUCTION();
+            }
+        }
+        /* FYWEBKITMOD END */
         Identifier propertyName(callFrame, subscript.toString(callFrame));
         result = baseValue.get(callFrame, propertyName);
         CHECK_FOR_EXCEPTION();
@@ -3121,6 +3258,10 @@ skip_id_custom_self:
                 result = asString(baseValue)->getIndex(callFrame, i);
             else if (isJSByteArray(globalData, baseValue) && asByteArray(baseValue)->canAccessIndex(i))
                 result = asByteArray(baseValue)->getIndex(callFrame, i);
+            /* FYWEBKITMOD BEGIN */
+            else if (const TypedArrayDescriptor* descriptor = typedArrayDescriptorForIndex(globalData, baseValue, i))
+                result = getTypedArrayElement(callFrame, baseValue.asCell(), descriptor, i);
+            /* FYWEBKITMOD END */
             else
                 result = baseValue.get(callFrame, i);
         } else {
@@ -3169,6 +3310,17 @@ skip_id_custom_self:
                     jsByteArray->setIndex(i, dValue);
                 else
                     baseValue.put(callFrame, i, jsValue);
+            /* FYWEBKITMOD BEGIN */
+            } else if (const TypedArrayDescriptor* descriptor = typedArrayDescriptorForIndex(globalData, baseValue, i)) {
+                double dValue = 0;
+                JSValue jsValue = callFrame->r(value).jsValue();
+                if (jsValue.isInt32())
+                    putTypedArrayElement(baseValue.asCell(), descriptor, i, jsValue.asInt32());
+                else if (jsValue.getNumber(dValue))
+                    putTypedArrayElement(baseValue.asCell(), descriptor, i, dValue);
+                else
+                    baseValue.put(callFrame, i, jsValue);
+            /* FYWEBKITMOD END */
             } else
                 baseValue.put(callFrame, i, callFrame->r(value).jsValue());
         } else {
@@ -4138,7 +4290,7 @@ skip_id_custom_self:
         Structure* structure;
         JSValue proto = callFrame->r(protoRegister).jsValue();
         if (proto.isObject())
-            structure = asObject(proto)->inheritorID();
+            structure = asObject(proto)->inheritorID(constructor->jsExecutable()->constructedPropertyCount()); // FYWEBKITMOD
         else
             structure = constructor->scope().node()->globalObject->emptyObjectStructure();
         callFrame->r(thisRegister) = JSValue(new (&callFrame->globalData()) JSObject(structure));
@@ -4146,6 +4298,24 @@ skip_id_custom_self:
         vPC += OPCODE_LENGTH(op_create_this);
         NEXT_INSTRUCTION();
     }
+    /* FYWEBKITMOD BEGIN */
+    DEFINE_OPCODE(op_record_this_size) {
+        /* record_this_size this(r)
+
+           Records the number of properties the object being constructed
+           has, so that the objects constructed after it start out with
+           room for them. This opcode is emitted before every return from
+           a constructor. Dictionaries are not recorded, their objects are
+           used as hash tables and say nothing about the next object.
+        */
+        Structure* thisStructure = asObject(callFrame->r(vPC[1].u.operand).jsValue())->structure();
+        if (!thisStructure->isDictionary())
+            asFunction(callFrame->callee())->jsExecutable()->recordConstructedPropertyCount(thisStructure->propertyStorageSize());
+
+        vPC += OPCODE_LENGTH(op_record_this_size);
+        NEXT_INSTRUCTION();
+    }
+    /* FYWEBKITMOD END */
     DEFINE_OPCODE(op_convert_this) {
         /* convert_this this(r)
 
@@ -4198,6 +4368,79 @@ skip_id_custom_self:
         vPC += OPCODE_LENGTH(op_create_arguments);
         NEXT_INSTRUCTION();
     }
+    /* FYWEBKITMOD BEGIN */
+    DEFINE_OPCODE(op_get_arguments_length) {
+        /* get_arguments_length dst(r) arguments(r) property(id)
+
+           Reads arguments.length. While 'arguments' has not been
+           created, the count is taken from the call frame. Otherwise
+           the length property is read from whatever 'arguments' holds.
+        */
+        int dst = vPC[1].u.operand;
+        int arguments = vPC[2].u.operand;
+
+        JSValue argumentsValue = callFrame->r(arguments).jsValue();
+        if (!argumentsValue) {
+            ++JSActivation::allocationStatistics().argumentReads;
+            callFrame->r(dst) = jsNumber(callFrame, callFrame->argumentCount());
+            vPC += OPCODE_LENGTH(op_get_arguments_length);
+            NEXT_INSTRUCTION();
+        }
+
+        Identifier& ident = codeBlock->identifier(vPC[3].u.operand);
+        PropertySlot slot(argumentsValue);
+        JSValue result = argumentsValue.get(callFrame, ident, slot);
+        CHECK_FOR_EXCEPTION();
+        callFrame->r(dst) = result;
+        vPC += OPCODE_LENGTH(op_get_arguments_length);
+        NEXT_INSTRUCTION();
+    }
+    DEFINE_OPCODE(op_get_argument_by_val) {
+        /* get_argument_by_val dst(r) arguments(r) property(r)
+
+           Reads arguments[property]. While 'arguments' has not been
+           created, an index below the argument count is read straight
+           from the call frame. Anything else creates the Arguments
+           object, as create_arguments does, and reads from it.
+        */
+        int dst = vPC[1].u.operand;
+        int arguments = vPC[2].u.operand;
+        JSValue subscript = callFrame->r(vPC[3].u.operand).jsValue();
+
+        JSValue argumentsValue = callFrame->r(arguments).jsValue();
+        if (!argumentsValue) {
+            size_t argumentCount = callFrame->argumentCount();
+            if (subscript.isUInt32() && subscript.asUInt32() < argumentCount) {
+                int32_t i = static_cast<int32_t>(subscript.asUInt32());
+                int32_t expectedParams = codeBlock->m_numParameters - 1;
+                // Same layout as op_load_varargs: declared parameters in place, the rest above 'this'.
+                if (i < expectedParams)
+                    callFrame->r(dst) = callFrame->registers()[i - RegisterFile::CallFrameHeaderSize - expectedParams];
+                else
+                    callFrame->r(dst) = callFrame->registers()[i - RegisterFile::CallFrameHeaderSize - expectedParams - static_cast<int32_t>(argumentCount) - 1];
+                ++JSActivation::allocationStatistics().argumentReads;
+                vPC += OPCODE_LENGTH(op_get_argument_by_val);
+                NEXT_INSTRUCTION();
+            }
+            Arguments* argumentsObject = new (globalData) Arguments(callFrame);
+            argumentsValue = JSValue(argumentsObject);
+            callFrame->r(arguments) = argumentsValue;
+            callFrame->r(unmodifiedArgumentsRegister(arguments)) = argumentsValue;
+        }
+
+        JSValue result;
+        if (LIKELY(subscript.isUInt32()))
+            result = argumentsValue.get(callFrame, subscript.asUInt32());
+        else {
+            Identifier property(callFrame, subscript.toString(callFrame));
+            result = argumentsValue.get(callFrame, property);
+        }
+        CHECK_FOR_EXCEPTION();
+        callFrame->r(dst) = result;
+        vPC += OPCODE_LENGTH(op_get_argument_by_val);
+        NEXT_INSTRUCTION();
+    }
+    /* FYWEBKITMOD END */
     DEFINE_OPCODE(op_construct) {
         /* construct func(r) argCount(n) registerOffset(n) proto(r) thisRegister(r)
 
@@ -4348,6 +4591,8 @@ skip_id_custom_self:
         JSPropertyNameIterator* jsPropertyNameIterator = structure->enumerationCache();
         if (!jsPropertyNameIterator || jsPropertyNameIterator->cachedPrototypeChain() != structure->prototypeChain(callFrame))
             jsPropertyNameIterator = JSPropertyNameIterator::create(callFrame, o);
+        else
+            JSPropertyNameIterator::recordCacheHit(structure); // FYWEBKITMOD
 
         callFrame->r(dst) = jsPropertyNameIterator;
         callFrame->r(base) = JSValue(o);
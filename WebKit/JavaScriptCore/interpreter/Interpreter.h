@@ -70,7 +70,7 @@ namespace JSC {
         friend class JIT;
         friend class CachedCall;
     public:
-        Interpreter();
+        Interpreter(size_t registerFileCapacity = RegisterFile::defaultCapacity); // FYWEBKITMOD
 
         RegisterFile& registerFile() { return m_registerFile; }
         
@@ -73,4 +73,23 @@ JSGlobalObject* RegisterFile::globalObject()
     return m_globalObject.get();
 }
 
+/* FYWEBKITMOD BEGIN */
+RegisterFileStatistics RegisterFile::statistics() const
+{
+    RegisterFileStatistics result;
+    result.reservedBytes = ((m_max - m_start) + m_maxGlobals) * sizeof(Register);
+#if HAVE(MMAP)
+    // Pages are committed when first touched.
+    result.committedBytes = (m_maxUsed - m_buffer) * sizeof(Register);
+#elif HAVE(VIRTUALALLOC)
+    result.committedBytes = reinterpret_cast<char*>(m_commitEnd) - reinterpret_cast<char*>(m_buffer);
+#else
+    result.committedBytes = result.reservedBytes;
+#endif
+    result.highWaterBytes = (m_highWaterMark - m_start) * sizeof(Register);
+    result.overflows = m_overflows;
+    return result;
+}
+/* FYWEBKITMOD END */
+
 } // namespace JSC
@@ -93,6 +93,15 @@ namespace JSC {
 
     class JSGlobalObject;
 
+    /* FYWEBKITMOD BEGIN */
+    struct RegisterFileStatistics {
+        size_t reservedBytes; // capacity plus globals; allocated up front where memory can't be committed on demand
+        size_t committedBytes; // of those, backed by memory
+        size_t highWaterBytes; // deepest use by call frames since startup
+        unsigned overflows; // grow() calls refused because the capacity was reached
+    };
+    /* FYWEBKITMOD END */
+
     class RegisterFile : public Noncopyable {
         friend class JIT;
     public:
@@ -110,6 +119,7 @@ namespace JSC {
         enum { ProgramCodeThisRegister = -CallFrameHeaderSize - 1 };
 
         static const size_t defaultCapacity = 524288;
+        static const size_t smallCapacity = 65536; // FYWEBKITMOD: default for contexts on small thread stacks
         static const size_t defaultMaxGlobals = 8192;
         static const size_t commitSize = 1 << 14;
         // Allow 8k of excess registers before we start trying to reap the registerfile
@@ -121,6 +131,7 @@ namespace JSC {
         Register* start() const { return m_start; }
         Register* end() const { return m_end; }
         size_t size() const { return m_end - m_start; }
+        size_t capacity() const { return m_max - m_start; } // FYWEBKITMOD
 
         void setGlobalObject(JSGlobalObject*);
         bool clearGlobalObject(JSGlobalObject*);
@@ -138,6 +149,8 @@ namespace JSC {
         void markGlobals(MarkStack& markStack, Heap* heap) { heap->markConservatively(markStack, lastGlobal(), m_start); }
         void markCallFrames(MarkStack& markStack, Heap* heap) { heap->markConservatively(markStack, m_start, m_end); }
 
+        RegisterFileStatistics statistics() const; // FYWEBKITMOD
+
     private:
         void releaseExcessCapacity();
         size_t m_numGlobals;
@@ -147,6 +160,10 @@ namespace JSC {
         Register* m_max;
         Register* m_buffer;
         Register* m_maxUsed;
+        /* FYWEBKITMOD BEGIN */
+        Register* m_highWaterMark; // Unlike m_maxUsed, not reset when excess capacity is released.
+        unsigned m_overflows;
+        /* FYWEBKITMOD END */
 
 #if HAVE(VIRTUALALLOC)
         Register* m_commitEnd;
@@ -216,6 +233,8 @@ namespace JSC {
         m_start = m_buffer + maxGlobals;
         m_end = m_start;
         m_maxUsed = m_end;
+        m_highWaterMark = m_end; // FYWEBKITMOD
+        m_overflows = 0; // FYWEBKITMOD
         m_max = m_start + capacity;
     }
 
@@ -233,8 +252,10 @@ namespace JSC {
         if (newEnd < m_end)
             return true;
 
-        if (newEnd > m_max)
+        if (newEnd > m_max) {
+            ++m_overflows; // FYWEBKITMOD
             return false;
+        }
 
 #if !HAVE(MMAP) && HAVE(VIRTUALALLOC)
         if (newEnd > m_commitEnd) {
@@ -251,8 +272,13 @@ namespace JSC {
         }
 #endif
 
-        if (newEnd > m_maxUsed)
+        if (newEnd > m_maxUsed) {
             m_maxUsed = newEnd;
+            /* FYWEBKITMOD BEGIN */
+            if (newEnd > m_highWaterMark)
+                m_highWaterMark = newEnd;
+            /* FYWEBKITMOD END */
+        }
 
         m_end = newEnd;
         return true;
@@ -341,6 +341,14 @@ void JIT::privateCompileMainPass()
         case op_put_by_id_generic:
         case op_put_by_id_replace:
         case op_put_by_id_transition:
+        /* FYWEBKITMOD BEGIN */
+        // Only emitted for the interpreter.
+        case op_get_arguments_length:
+        case op_get_argument_by_val:
+        case op_new_object_literal:
+        case op_end_object_literal:
+        case op_record_this_size:
+        /* FYWEBKITMOD END */
             ASSERT_NOT_REACHED();
         }
     }
@@ -3210,6 +3210,8 @@ DEFINE_STUB_FUNCTION(JSPropertyNameIterator*, op_get_pnames)
     JSPropertyNameIterator* jsPropertyNameIterator = structure->enumerationCache();
     if (!jsPropertyNameIterator || jsPropertyNameIterator->cachedPrototypeChain() != structure->prototypeChain(callFrame))
         jsPropertyNameIterator = JSPropertyNameIterator::create(callFrame, o);
+    else
+        JSPropertyNameIterator::recordCacheHit(structure); // FYWEBKITMOD
     return jsPropertyNameIterator;
 }
 
@@ -199,6 +199,11 @@ private:
     int m_assignmentCount;
     int m_nonLHSCount;
     bool m_syntaxAlreadyValidated;
+    /* FYWEBKITMOD BEGIN */
+    int m_functionDepth;
+    IdentifierSet m_capturedVariables;
+    bool m_nestedFunctionUsesEval;
+    /* FYWEBKITMOD END */
 };
 
 int jsParse(JSGlobalData* globalData, const SourceCode* source)
@@ -219,6 +224,8 @@ JSParser::JSParser(Lexer* lexer, JSGlobalData* globalData, SourceProvider* provi
     , m_assignmentCount(0)
     , m_nonLHSCount(0)
     , m_syntaxAlreadyValidated(provider->isValid())
+    , m_functionDepth(0) // FYWEBKITMOD
+    , m_nestedFunctionUsesEval(false) // FYWEBKITMOD
 {
     m_endAddress = *(globalData->stackGuards);
     if (!m_endAddress) {
@@ -238,6 +245,7 @@ bool JSParser::parseProgram()
         return true;
     m_globalData->parser->didFinishParsing(sourceElements, context.varDeclarations(), context.funcDeclarations(), context.features(),
                                           m_lastLine, context.numConstants());
+    m_globalData->parser->didFinishCaptureAnalysis(m_capturedVariables, m_nestedFunctionUsesEval); // FYWEBKITMOD
     return false;
 }
 
@@ -805,7 +813,9 @@ template <JSParser::FunctionRequirements requirements, class TreeBuilder> bool J
     bodyStartLine = tokenLine();
     next();
 
+    ++m_functionDepth; // FYWEBKITMOD
     body = parseFunctionBody(context);
+    --m_functionDepth; // FYWEBKITMOD
     failIfFalse(body);
     if (usesArguments)
         context.setUsesArguments(body);
@@ -1286,6 +1296,16 @@ template <class TreeBuilder> TreeExpression JSParser::parsePrimaryExpression(Tre
         int start = tokenStart();
         const Identifier* ident = token().m_data.ident;
         next();
+        /* FYWEBKITMOD BEGIN */
+        // Remember which names nested functions refer to, so that a function whose closures
+        // use none of its locals can do without an activation.
+        if (m_functionDepth) {
+            if (*ident == m_globalData->propertyNames->eval)
+                m_nestedFunctionUsesEval = true;
+            else
+                m_capturedVariables.add(ident->ustring().rep());
+        }
+        /* FYWEBKITMOD END */
         return context.createResolve(ident, start);
     }
     case STRING: {
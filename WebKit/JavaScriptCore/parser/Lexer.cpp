@@ -221,6 +221,110 @@ static const unsigned short typesOfASCIICharacters[128] = {
 /* 127 - Delete             */ CharacterInvalid,
 };
 
+/* FYWEBKITMOD BEGIN */
+// Keywords are recognized on the characters of an identifier, before it is interned.
+// Same words and tokens as parser/Keywords.table; keywordSlots is a perfect hash of them
+// over (first character + second character + 26 * length) & 127.
+static const struct {
+    const char* name;
+    JSTokenType token;
+} keywords[] = {
+    { "null", NULLTOKEN }, { "true", TRUETOKEN }, { "false", FALSETOKEN }, { "break", BREAK },
+    { "case", CASE }, { "catch", CATCH }, { "const", CONSTTOKEN }, { "default", DEFAULT },
+    { "finally", FINALLY }, { "for", FOR }, { "instanceof", INSTANCEOF }, { "new", NEW },
+    { "var", VAR }, { "continue", CONTINUE }, { "function", FUNCTION }, { "return", RETURN },
+    { "void", VOIDTOKEN }, { "delete", DELETETOKEN }, { "if", IF }, { "this", THISTOKEN },
+    { "do", DO }, { "while", WHILE }, { "else", ELSE }, { "in", INTOKEN },
+    { "switch", SWITCH }, { "throw", THROW }, { "try", TRY }, { "typeof", TYPEOF },
+    { "with", WITH }, { "debugger", DEBUGGER }, { "class", RESERVED }, { "enum", RESERVED },
+    { "export", RESERVED }, { "extends", RESERVED }, { "import", RESERVED }, { "super", RESERVED }
+};
+
+static const size_t numberOfKeywords = sizeof(keywords) / sizeof(keywords[0]);
+static const size_t shortestKeywordLength = 2;
+static const size_t longestKeywordLength = 10;
+
+static const signed char keywordSlots[128] = {
+    -1, -1, -1, 18, -1,  8, 24, 20, -1, 27, -1, 23, -1, -1, -1, -1,
+    -1, -1, -1, 33, -1, -1, -1, -1, -1, 29, -1, -1, -1, -1, -1, -1,
+    -1, 11, 13,  9, -1, 12, -1, -1, -1, -1, -1, 14,  4, -1, -1, -1,
+    -1, -1, -1, -1, 26, -1, -1, -1, -1, 22, -1, 31, -1, -1, -1, -1,
+    -1, -1, -1, -1, 19, -1,  5, -1, 28,  2, -1,  0, -1, 16,  1, -1,
+    -1, 30, -1, -1,  6, -1,  3, -1, -1, -1, -1, 10, -1, -1, 25, -1,
+    -1, 21, -1, -1, -1, 17, -1, -1, -1, -1, 35, -1, -1, -1, -1, -1,
+    -1, -1, 34, 15, -1, -1, -1, -1, -1, 32, -1, -1, -1, -1, -1,  7,
+};
+
+// Index into keywords of the keyword spelled by the characters, or -1.
+static ALWAYS_INLINE int keywordIndex(const UChar* characters, size_t length)
+{
+    if (length < shortestKeywordLength || length > longestKeywordLength)
+        return -1;
+
+    int index = keywordSlots[(characters[0] + characters[1] + 26 * length) & 127];
+    if (index < 0)
+        return -1;
+
+    const char* name = keywords[index].name;
+    for (size_t i = 0; i < length; ++i) {
+        if (characters[i] != static_cast<unsigned char>(name[i]))
+            return -1;
+    }
+    return name[length] ? -1 : index;
+}
+
+// Computes WTF::stringHash() of an identifier while it is being scanned, so interning it
+// doesn't need another pass over the characters.
+class IdentifierHasher {
+public:
+    IdentifierHasher()
+        : m_hash(WTF::stringHashingStartValue)
+        , m_pendingCharacter(0)
+        , m_hasPendingCharacter(false)
+    {
+    }
+
+    ALWAYS_INLINE void add(UChar character)
+    {
+        if (!m_hasPendingCharacter) {
+            m_pendingCharacter = character;
+            m_hasPendingCharacter = true;
+            return;
+        }
+        m_hash += m_pendingCharacter;
+        unsigned tmp = (character << 11) ^ m_hash;
+        m_hash = (m_hash << 16) ^ tmp;
+        m_hash += m_hash >> 11;
+        m_hasPendingCharacter = false;
+    }
+
+    unsigned hash() const
+    {
+        unsigned hash = m_hash;
+        if (m_hasPendingCharacter) {
+            hash += m_pendingCharacter;
+            hash ^= hash << 11;
+            hash += hash >> 17;
+        }
+
+        hash ^= hash << 3;
+        hash += hash >> 5;
+        hash ^= hash << 2;
+        hash += hash >> 15;
+        hash ^= hash << 10;
+        hash &= 0x7fffffff;
+        if (!hash)
+            hash = 0x40000000;
+        return hash;
+    }
+
+private:
+    unsigned m_hash;
+    UChar m_pendingCharacter;
+    bool m_hasPendingCharacter;
+};
+/* FYWEBKITMOD END */
+
 Lexer::Lexer(JSGlobalData* globalData)
     : m_isReparsing(false)
     , m_globalData(globalData)
@@ -248,6 +352,14 @@ void Lexer::setCode(const SourceCode& source, ParserArena& arena)
 {
     m_arena = &arena.identifierArena();
 
+    /* FYWEBKITMOD BEGIN */
+    if (m_keywordIdentifiers.isEmpty()) {
+        m_keywordIdentifiers.reserveInitialCapacity(numberOfKeywords);
+        for (size_t i = 0; i < numberOfKeywords; ++i)
+            m_keywordIdentifiers.uncheckedAppend(Identifier(m_globalData, keywords[i].name));
+    }
+    /* FYWEBKITMOD END */
+
     m_lineNumber = source.firstLine();
     m_delimited = false;
     m_lastToken = -1;
@@ -325,6 +437,11 @@ ALWAYS_INLINE const Identifier* Lexer::makeIdentifier(const UChar* characters, s
     return &m_arena->makeIdentifier(m_globalData, characters, length);
 }
 
+ALWAYS_INLINE const Identifier* Lexer::makeIdentifier(const UChar* characters, size_t length, unsigned hash) // FYWEBKITMOD
+{
+    return &m_arena->makeIdentifier(m_globalData, characters, length, hash);
+}
+
 ALWAYS_INLINE bool Lexer::lastTokenWasRestrKeyword() const
 {
     return m_lastToken == CONTINUE || m_lastToken == BREAK || m_lastToken == RETURN || m_lastToken == THROW;
@@ -805,14 +922,33 @@ startIdentifierWithBackslash: {
 
 startIdentifierOrKeyword: {
     const UChar* identifierStart = currentCharacter();
+    /* FYWEBKITMOD BEGIN */
+    IdentifierHasher hasher;
+    hasher.add(m_current);
     shift();
-    while (isIdentPart(m_current))
+    while (isIdentPart(m_current)) {
+        hasher.add(m_current);
         shift();
+    }
     if (LIKELY(m_current != '\\')) {
-        // Fast case for idents which does not contain \uCCCC characters
-        lvalp->ident = makeIdentifier(identifierStart, currentCharacter() - identifierStart);
-        goto doneIdentifierOrKeyword;
+        // Fast case for idents which does not contain \uCCCC characters. Keywords get their
+        // token and a premade identifier, everything else is interned with the hash taken
+        // while scanning.
+        size_t length = currentCharacter() - identifierStart;
+        int keyword = keywordIndex(identifierStart, length);
+        if (keyword >= 0) {
+            lvalp->ident = &m_keywordIdentifiers[keyword];
+            token = lexType == IdentifyReservedWords ? keywords[keyword].token : IDENT;
+        } else {
+            lvalp->ident = makeIdentifier(identifierStart, length, hasher.hash());
+            ASSERT(!m_keywordTable.entry(m_globalData, *lvalp->ident));
+            token = IDENT;
+        }
+        m_atLineStart = false;
+        m_delimited = false;
+        goto returnToken;
     }
+    /* FYWEBKITMOD END */
     m_buffer16.append(identifierStart, currentCharacter() - identifierStart);
 }
 
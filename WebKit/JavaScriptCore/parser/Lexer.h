@@ -91,6 +91,7 @@ namespace JSC {
         ALWAYS_INLINE int currentOffset() const;
 
         ALWAYS_INLINE const Identifier* makeIdentifier(const UChar* characters, size_t length);
+        ALWAYS_INLINE const Identifier* makeIdentifier(const UChar* characters, size_t length, unsigned hash); // FYWEBKITMOD
 
         ALWAYS_INLINE bool lastTokenWasRestrKeyword() const;
 
@@ -123,6 +124,7 @@ namespace JSC {
         JSGlobalData* m_globalData;
 
         const HashTable m_keywordTable;
+        Vector<Identifier> m_keywordIdentifiers; // FYWEBKITMOD
     };
 
     inline bool Lexer::isWhiteSpace(int ch)
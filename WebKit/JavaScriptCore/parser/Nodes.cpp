@@ -78,6 +78,7 @@ StatementNode* SourceElements::singleStatement() const
 ScopeNodeData::ScopeNodeData(ParserArena& arena, SourceElements* statements, VarStack* varStack, FunctionStack* funcStack, int numConstants)
     : m_numConstants(numConstants)
     , m_statements(statements)
+    , m_nestedFunctionUsesEval(false) // FYWEBKITMOD
 {
     m_arena.swap(arena);
     if (varStack)
@@ -104,6 +105,15 @@ ScopeNode::ScopeNode(JSGlobalData* globalData, const SourceCode& source, SourceE
 {
 }
 
+/* FYWEBKITMOD BEGIN */
+void ScopeNode::setCapturedVariables(IdentifierSet& capturedVariables, bool nestedFunctionUsesEval)
+{
+    ASSERT(m_data);
+    m_data->m_capturedVariables.swap(capturedVariables);
+    m_data->m_nestedFunctionUsesEval = nestedFunctionUsesEval;
+}
+/* FYWEBKITMOD END */
+
 StatementNode* ScopeNode::singleStatement() const
 {
     return m_data->m_statements ? m_data->m_statements->singleStatement() : 0;
@@ -174,7 +184,42 @@ void FunctionBodyNode::finishParsing(PassRefPtr<FunctionParameters> parameters,
     ASSERT(!source().isNull());
     m_parameters = parameters;
     m_ident = ident;
-}
+    /* FYWEBKITMOD BEGIN */
+    // ClosureFeature only says that the body contains functions. If none of them refers to
+    // a parameter, variable or function of this one, the locals can stay in registers and
+    // no activation has to be created or torn off.
+    if (data() && (features() & ClosureFeature) && !hasCapturedVariables())
+        setFeatures(features() & ~ClosureFeature);
+    /* FYWEBKITMOD END */
+}
+
+/* FYWEBKITMOD BEGIN */
+bool FunctionBodyNode::hasCapturedVariables()
+{
+    // A nested eval can reach any local by name.
+    if (data()->m_nestedFunctionUsesEval)
+        return true;
+    IdentifierSet& captured = data()->m_capturedVariables;
+    if (captured.isEmpty())
+        return false;
+
+    for (size_t i = 0; i < m_parameters->size(); ++i) {
+        if (captured.contains(m_parameters->at(i).ustring().rep()))
+            return true;
+    }
+    VarStack& vars = varStack();
+    for (size_t i = 0; i < vars.size(); ++i) {
+        if (captured.contains(vars[i].first->ustring().rep()))
+            return true;
+    }
+    FunctionStack& functions = functionStack();
+    for (size_t i = 0; i < functions.size(); ++i) {
+        if (captured.contains(functions[i]->ident().ustring().rep()))
+            return true;
+    }
+    return false;
+}
+/* FYWEBKITMOD END */
 
 FunctionBodyNode* FunctionBodyNode::create(JSGlobalData* globalData)
 {
@@ -34,6 +34,7 @@
 #include "ResultType.h"
 #include "SourceCode.h"
 #include "SymbolTable.h"
+#include <wtf/HashSet.h> // FYWEBKITMOD
 #include <wtf/MathExtras.h>
 
 namespace JSC {
@@ -88,6 +89,11 @@ namespace JSC {
         typedef Vector<FunctionBodyNode*> FunctionStack;
     }
 
+    /* FYWEBKITMOD BEGIN */
+    // Names referenced from inside nested functions.
+    typedef HashSet<RefPtr<UString::Rep>, IdentifierRepHash> IdentifierSet;
+    /* FYWEBKITMOD END */
+
     struct SwitchInfo {
         enum SwitchType { SwitchNone, SwitchImmediate, SwitchCharacter, SwitchString };
         uint32_t bytecodeOffset;
@@ -1391,6 +1397,10 @@ namespace JSC {
         FunctionStack m_functionStack;
         int m_numConstants;
         SourceElements* m_statements;
+        /* FYWEBKITMOD BEGIN */
+        IdentifierSet m_capturedVariables;
+        bool m_nestedFunctionUsesEval;
+        /* FYWEBKITMOD END */
     };
 
     class ScopeNode : public StatementNode, public ParserArenaRefCounted {
@@ -1421,6 +1431,9 @@ namespace JSC {
 
         VarStack& varStack() { ASSERT(m_data); return m_data->m_varStack; }
         FunctionStack& functionStack() { ASSERT(m_data); return m_data->m_functionStack; }
+        /* FYWEBKITMOD BEGIN */
+        void setCapturedVariables(IdentifierSet&, bool nestedFunctionUsesEval);
+        /* FYWEBKITMOD END */
 
         int neededConstants()
         {
@@ -1496,6 +1509,8 @@ namespace JSC {
         FunctionBodyNode(JSGlobalData*);
         FunctionBodyNode(JSGlobalData*, SourceElements*, VarStack*, FunctionStack*, const SourceCode&, CodeFeatures, int numConstants);
 
+        bool hasCapturedVariables(); // FYWEBKITMOD
+
         Identifier m_ident;
         RefPtr<FunctionParameters> m_parameters;
     };
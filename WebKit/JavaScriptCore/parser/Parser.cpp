@@ -76,4 +76,12 @@ void Parser::didFinishParsing(SourceElements* sourceElements, ParserArenaData<De
     m_numConstants = numConstants;
 }
 
+/* FYWEBKITMOD BEGIN */
+void Parser::didFinishCaptureAnalysis(IdentifierSet& capturedVariables, bool nestedFunctionUsesEval)
+{
+    m_capturedVariables.swap(capturedVariables);
+    m_nestedFunctionUsesEval = nestedFunctionUsesEval;
+}
+/* FYWEBKITMOD END */
+
 } // namespace JSC
@@ -52,6 +52,7 @@ namespace JSC {
 
         void didFinishParsing(SourceElements*, ParserArenaData<DeclarationStacks::VarStack>*, 
                               ParserArenaData<DeclarationStacks::FunctionStack>*, CodeFeatures features, int lastLine, int numConstants);
+        void didFinishCaptureAnalysis(IdentifierSet& capturedVariables, bool nestedFunctionUsesEval); // FYWEBKITMOD
 
         ParserArena& arena() { return m_arena; }
 
@@ -70,6 +71,10 @@ namespace JSC {
         CodeFeatures m_features;
         int m_lastLine;
         int m_numConstants;
+        /* FYWEBKITMOD BEGIN */
+        IdentifierSet m_capturedVariables;
+        bool m_nestedFunctionUsesEval;
+        /* FYWEBKITMOD END */
     };
 
     template <class ParsedNode>
@@ -94,6 +99,7 @@ namespace JSC {
             m_features,
             m_numConstants);
             result->setLoc(m_source->firstLine(), m_lastLine);
+            result->setCapturedVariables(m_capturedVariables, m_nestedFunctionUsesEval); // FYWEBKITMOD
         } else if (lexicalGlobalObject) {
             // We can never see a syntax error when reparsing a function, since we should have
             // reported the error when parsing the containing program or eval code. So if we're
@@ -113,6 +119,10 @@ namespace JSC {
         m_sourceElements = 0;
         m_varDeclarations = 0;
         m_funcDeclarations = 0;
+        /* FYWEBKITMOD BEGIN */
+        m_capturedVariables.clear();
+        m_nestedFunctionUsesEval = false;
+        /* FYWEBKITMOD END */
 
         if (debugger && !ParsedNode::scopeIsFunction)
             debugger->sourceParsed(debuggerExecState, source, errLine, errMsg);
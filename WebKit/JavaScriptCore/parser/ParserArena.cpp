@@ -28,6 +28,7 @@
 
 #include "Nodes.h"
 #include <wtf/PassOwnPtr.h>
+#include <wtf/StdLibExtras.h> // FYWEBKITMOD
 
 namespace JSC {
 
@@ -44,14 +45,55 @@ inline void* ParserArena::freeablePool()
     return m_freeablePoolEnd - freeablePoolSize;
 }
 
+/* FYWEBKITMOD BEGIN */
+// Every parse, including the lazy compile of each function, fills an arena and frees it
+// right after. A few of the pools are kept around for the next parse instead of going
+// back to fastMalloc every time. Only done where JSC doesn't run on multiple threads.
+#if !ENABLE(JSC_MULTIPLE_THREADS)
+static const size_t maxUnusedFreeablePools = 16;
+typedef Vector<void*, maxUnusedFreeablePools> FreeablePoolVector;
+
+static FreeablePoolVector& unusedFreeablePools()
+{
+    DEFINE_STATIC_LOCAL(FreeablePoolVector, pools, ());
+    return pools;
+}
+#endif
+
+static inline void* allocatePool(size_t size)
+{
+#if !ENABLE(JSC_MULTIPLE_THREADS)
+    FreeablePoolVector& pools = unusedFreeablePools();
+    if (!pools.isEmpty()) {
+        void* pool = pools.last();
+        pools.removeLast();
+        return pool;
+    }
+#endif
+    return fastMalloc(size);
+}
+
+static inline void freePool(void* pool)
+{
+#if !ENABLE(JSC_MULTIPLE_THREADS)
+    FreeablePoolVector& pools = unusedFreeablePools();
+    if (pools.size() < maxUnusedFreeablePools) {
+        pools.append(pool);
+        return;
+    }
+#endif
+    fastFree(pool);
+}
+/* FYWEBKITMOD END */
+
 inline void ParserArena::deallocateObjects()
 {
     if (m_freeablePoolEnd)
-        fastFree(freeablePool());
+        freePool(freeablePool()); // FYWEBKITMOD
 
     size_t size = m_freeablePools.size();
     for (size_t i = 0; i < size; ++i)
-        fastFree(m_freeablePools[i]);
+        freePool(m_freeablePools[i]); // FYWEBKITMOD
 
     size = m_deletableObjects.size();
     for (size_t i = 0; i < size; ++i) {
@@ -86,6 +128,7 @@ void ParserArena::reset()
     // Since this code path is used only when parsing fails, it's not bothering to reuse
     // any of the memory the arena allocated. We could improve that later if we want to
     // efficiently reuse the same arena.
+    // FYWEBKITMOD: the freeable pools do get reused by later parses, see freePool().
 
     deallocateObjects();
 
@@ -102,7 +145,7 @@ void ParserArena::allocateFreeablePool()
     if (m_freeablePoolEnd)
         m_freeablePools.append(freeablePool());
 
-    char* pool = static_cast<char*>(fastMalloc(freeablePoolSize));
+    char* pool = static_cast<char*>(allocatePool(freeablePoolSize)); // FYWEBKITMOD
     m_freeableMemory = pool;
     m_freeablePoolEnd = pool + freeablePoolSize;
     ASSERT(freeablePool() == pool);
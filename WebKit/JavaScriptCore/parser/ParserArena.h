@@ -36,15 +36,32 @@ namespace JSC {
 
     class IdentifierArena : public FastAllocBase {
     public:
+        /* FYWEBKITMOD BEGIN */
+        IdentifierArena()
+        {
+            clearRecentIdentifiers();
+        }
+        /* FYWEBKITMOD END */
+
         ALWAYS_INLINE const Identifier& makeIdentifier(JSGlobalData*, const UChar* characters, size_t length);
+        ALWAYS_INLINE const Identifier& makeIdentifier(JSGlobalData*, const UChar* characters, size_t length, unsigned hash); // FYWEBKITMOD
         const Identifier& makeNumericIdentifier(JSGlobalData*, double number);
 
-        void clear() { m_identifiers.clear(); }
+        void clear() { m_identifiers.clear(); clearRecentIdentifiers(); } // FYWEBKITMOD
         bool isEmpty() const { return m_identifiers.isEmpty(); }
 
     private:
         typedef SegmentedVector<Identifier, 64> IdentifierVector;
         IdentifierVector m_identifiers;
+
+        /* FYWEBKITMOD BEGIN */
+        // Scripts use the same few names over and over. The last identifier made for each
+        // slot is handed out again when the same characters come along, without going
+        // through the identifier table.
+        static const size_t recentIdentifierCount = 128;
+        void clearRecentIdentifiers() { memset(m_recentIdentifiers, 0, sizeof(m_recentIdentifiers)); }
+        const Identifier* m_recentIdentifiers[recentIdentifierCount];
+        /* FYWEBKITMOD END */
     };
 
     ALWAYS_INLINE const Identifier& IdentifierArena::makeIdentifier(JSGlobalData* globalData, const UChar* characters, size_t length)
@@ -53,6 +70,19 @@ namespace JSC {
         return m_identifiers.last();
     }
 
+    /* FYWEBKITMOD BEGIN */
+    ALWAYS_INLINE const Identifier& IdentifierArena::makeIdentifier(JSGlobalData* globalData, const UChar* characters, size_t length, unsigned hash)
+    {
+        const Identifier*& recent = m_recentIdentifiers[hash & (recentIdentifierCount - 1)];
+        if (recent && recent->ustring().rep()->hash() == hash && Identifier::equal(recent->ustring().rep(), characters, length))
+            return *recent;
+
+        m_identifiers.append(Identifier(globalData, characters, length, hash));
+        recent = &m_identifiers.last();
+        return *recent;
+    }
+    /* FYWEBKITMOD END */
+
     inline const Identifier& IdentifierArena::makeNumericIdentifier(JSGlobalData* globalData, double number)
     {
         m_identifiers.append(Identifier(globalData, UString::from(number)));
@@ -172,6 +172,8 @@ namespace JSC {
         d->callee = callee;
         d->overrodeLength = false;
         d->overrodeCallee = false;
+
+        ++JSActivation::allocationStatistics().arguments; // FYWEBKITMOD
     }
 
     inline Arguments::Arguments(CallFrame* callFrame, NoParametersType)
@@ -201,6 +203,8 @@ namespace JSC {
         d->callee = asFunction(callFrame->callee());
         d->overrodeLength = false;
         d->overrodeCallee = false;
+
+        ++JSActivation::allocationStatistics().arguments; // FYWEBKITMOD
     }
 
     inline void Arguments::copyRegisters()
@@ -70,6 +70,7 @@ FunctionExecutable::FunctionExecutable(JSGlobalData* globalData, const Identifie
     , m_parameters(parameters)
     , m_name(name)
     , m_symbolTable(0)
+    , m_constructedPropertyCount(0) // FYWEBKITMOD
 {
     m_firstLine = firstLine;
     m_lastLine = lastLine;
@@ -82,6 +83,7 @@ FunctionExecutable::FunctionExecutable(ExecState* exec, const Identifier& name,
     , m_parameters(parameters)
     , m_name(name)
     , m_symbolTable(0)
+    , m_constructedPropertyCount(0) // FYWEBKITMOD
 {
     m_firstLine = firstLine;
     m_lastLine = lastLine;
@@ -349,6 +349,22 @@ namespace JSC {
         UString paramString() const;
         SharedSymbolTable* symbolTable() const { return m_symbolTable; }
 
+        /* FYWEBKITMOD BEGIN */
+        // The most properties an object constructed by this function had when the constructor
+        // returned. Objects it constructs later start out with room for that many. Objects
+        // with more properties than an object takes transitions for (Structure's
+        // s_maxTransitionLength) are dictionaries and don't count beyond that.
+        static const size_t maxConstructedPropertyCount = 64;
+        size_t constructedPropertyCount() const { return m_constructedPropertyCount; }
+        void recordConstructedPropertyCount(size_t count)
+        {
+            if (count > maxConstructedPropertyCount)
+                count = maxConstructedPropertyCount;
+            if (count > m_constructedPropertyCount)
+                m_constructedPropertyCount = count;
+        }
+        /* FYWEBKITMOD END */
+
         void recompile(ExecState*);
         void markAggregate(MarkStack&);
         static PassRefPtr<FunctionExecutable> fromGlobalCode(const Identifier&, ExecState*, Debugger*, const SourceCode&, JSObject** exception);
@@ -370,6 +386,7 @@ namespace JSC {
         OwnPtr<FunctionCodeBlock> m_codeBlockForConstruct;
         Identifier m_name;
         SharedSymbolTable* m_symbolTable;
+        size_t m_constructedPropertyCount; // FYWEBKITMOD
 
 #if ENABLE(JIT)
     public:
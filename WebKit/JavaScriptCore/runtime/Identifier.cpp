@@ -186,6 +186,48 @@ PassRefPtr<UString::Rep> Identifier::add(JSGlobalData* globalData, const UChar*
     return addResult.second ? adoptRef(*addResult.first) : *addResult.first;
 }
 
+/* FYWEBKITMOD BEGIN */
+struct HashAndUCharBuffer {
+    const UChar* s;
+    unsigned length;
+    unsigned hash;
+};
+
+struct IdentifierHashAndUCharBufferTranslator {
+    static unsigned hash(const HashAndUCharBuffer& buf)
+    {
+        ASSERT(buf.hash == UString::Rep::computeHash(buf.s, buf.length));
+        return buf.hash;
+    }
+
+    static bool equal(UString::Rep* str, const HashAndUCharBuffer& buf)
+    {
+        return Identifier::equal(str, buf.s, buf.length);
+    }
+
+    static void translate(UString::Rep*& location, const HashAndUCharBuffer& buf, unsigned hash)
+    {
+        UCharBuffer charBuffer = { buf.s, buf.length };
+        IdentifierUCharBufferTranslator::translate(location, charBuffer, hash);
+    }
+};
+
+// Same as above for callers that already know the hash of the characters, like the lexer.
+PassRefPtr<UString::Rep> Identifier::add(JSGlobalData* globalData, const UChar* s, int length, unsigned existingHash)
+{
+    if (length == 1) {
+        UChar c = s[0];
+        if (c <= 0xFF)
+            return add(globalData, globalData->smallStrings.singleCharacterStringRep(c));
+    }
+    if (!length)
+        return UString::Rep::empty();
+    HashAndUCharBuffer buf = { s, static_cast<unsigned>(length), existingHash };
+    pair<HashSet<UString::Rep*>::iterator, bool> addResult = globalData->identifierTable->add<HashAndUCharBuffer, IdentifierHashAndUCharBufferTranslator>(buf);
+    return addResult.second ? adoptRef(*addResult.first) : *addResult.first;
+}
+/* FYWEBKITMOD END */
+
 PassRefPtr<UString::Rep> Identifier::add(ExecState* exec, const UChar* s, int length)
 {
     return add(&exec->globalData(), s, length);
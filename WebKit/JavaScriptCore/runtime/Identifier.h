@@ -44,6 +44,7 @@ namespace JSC {
 
         Identifier(JSGlobalData* globalData, const char* s) : _ustring(add(globalData, s)) { } // Only to be used with string literals.
         Identifier(JSGlobalData* globalData, const UChar* s, int length) : _ustring(add(globalData, s, length)) { }
+        Identifier(JSGlobalData* globalData, const UChar* s, int length, unsigned existingHash) : _ustring(add(globalData, s, length, existingHash)) { } // FYWEBKITMOD
         Identifier(JSGlobalData* globalData, UString::Rep* rep) : _ustring(add(globalData, rep)) { }
         Identifier(JSGlobalData* globalData, const UString& s) : _ustring(add(globalData, s.rep())) { }
 
@@ -94,6 +95,7 @@ namespace JSC {
 
         static PassRefPtr<UString::Rep> add(ExecState*, const UChar*, int length);
         static PassRefPtr<UString::Rep> add(JSGlobalData*, const UChar*, int length);
+        static PassRefPtr<UString::Rep> add(JSGlobalData*, const UChar*, int length, unsigned existingHash); // FYWEBKITMOD
 
         static PassRefPtr<UString::Rep> add(ExecState* exec, UString::Rep* r)
         {
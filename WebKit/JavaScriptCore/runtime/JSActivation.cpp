@@ -32,6 +32,7 @@
 #include "Arguments.h"
 #include "Interpreter.h"
 #include "JSFunction.h"
+#include <wtf/StdLibExtras.h> // FYWEBKITMOD
 
 namespace JSC {
 
@@ -42,8 +43,17 @@ const ClassInfo JSActivation::info = { "JSActivation", 0, 0, 0 };
 JSActivation::JSActivation(CallFrame* callFrame, NonNullPassRefPtr<FunctionExecutable> functionExecutable)
     : Base(callFrame->globalData().activationStructure, new JSActivationData(functionExecutable, callFrame->registers()))
 {
+    ++allocationStatistics().activations; // FYWEBKITMOD
 }
 
+/* FYWEBKITMOD BEGIN */
+ScopeAllocationStatistics& JSActivation::allocationStatistics()
+{
+    DEFINE_STATIC_LOCAL(ScopeAllocationStatistics, statistics, ());
+    return statistics;
+}
+/* FYWEBKITMOD END */
+
 JSActivation::~JSActivation()
 {
     delete d();
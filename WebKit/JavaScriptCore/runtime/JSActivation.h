@@ -38,6 +38,16 @@ namespace JSC {
 
     class Arguments;
     class Register;
+
+    /* FYWEBKITMOD BEGIN */
+    struct ScopeAllocationStatistics {
+        ScopeAllocationStatistics() : activations(0), arguments(0), argumentReads(0) { }
+
+        unsigned activations; // JSActivations created on function entry
+        unsigned arguments; // Arguments objects created
+        unsigned argumentReads; // arguments.length and arguments[i] read from the call frame without an Arguments object
+    };
+    /* FYWEBKITMOD END */
     
     class JSActivation : public JSVariableObject {
         typedef JSVariableObject Base;
@@ -45,6 +55,8 @@ namespace JSC {
         JSActivation(CallFrame*, NonNullPassRefPtr<FunctionExecutable>);
         virtual ~JSActivation();
 
+        static ScopeAllocationStatistics& allocationStatistics(); // FYWEBKITMOD
+
         virtual void markChildren(MarkStack&);
 
         virtual bool isDynamicScope(bool& requiresDynamicChecks) const;
@@ -88,6 +88,12 @@ namespace JSC {
             return m_storage->m_vector[i];
         }
 
+        /* FYWEBKITMOD BEGIN */
+        // Indices below usedVectorLength() are kept in the vector, any others in the sparse map.
+        unsigned usedVectorLength() const { return std::min(m_storage->m_length, m_vectorLength); }
+        bool hasSparseValues() const { return m_storage->m_sparseValueMap && !m_storage->m_sparseValueMap->isEmpty(); }
+        /* FYWEBKITMOD END */
+
         bool canSetIndex(unsigned i) { return i < m_vectorLength; }
         void setIndex(unsigned i, JSValue v)
         {
@@ -79,6 +79,28 @@ void* JSGlobalData::jsByteArrayVPtr;
 void* JSGlobalData::jsStringVPtr;
 void* JSGlobalData::jsFunctionVPtr;
 
+/* FYWEBKITMOD BEGIN */
+static JSGlobalData::StackLimits stackLimits[] = {
+    { RegisterFile::defaultCapacity, MaxLargeThreadReentryDepth }, // ThreadStackTypeLarge
+    { RegisterFile::smallCapacity, MaxSmallThreadReentryDepth } // ThreadStackTypeSmall
+};
+
+JSGlobalData::StackLimits JSGlobalData::defaultStackLimits(ThreadStackType type)
+{
+    return stackLimits[type];
+}
+
+void JSGlobalData::setDefaultStackLimits(ThreadStackType type, const StackLimits& limits)
+{
+    // RegisterFile wants its capacity page aligned, see isPageAligned(). The interpreter
+    // doesn't look at maxReentryDepth before MaxSmallThreadReentryDepth is reached.
+    const size_t registerBlock = 8 * 1024;
+    size_t capacity = std::max(limits.registerFileCapacity, registerBlock);
+    stackLimits[type].registerFileCapacity = (capacity + registerBlock - 1) & ~(registerBlock - 1);
+    stackLimits[type].maxReentryDepth = std::max<int>(limits.maxReentryDepth, MaxSmallThreadReentryDepth);
+}
+/* FYWEBKITMOD END */
+
 void JSGlobalData::storeVPtrs()
 {
     CollectorCell cell;
@@ -130,12 +152,13 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
 #if USE(JSVALUE32)
     , numberStructure(JSNumberCell::createStructure(jsNull()))
 #endif
+    , typedArrayDescriptorCount(0) // FYWEBKITMOD
     , identifierTable(globalDataType == Default ? wtfThreadData().currentIdentifierTable() : createIdentifierTable())
     , propertyNames(new CommonIdentifiers(this))
     , emptyList(new MarkedArgumentBuffer)
     , lexer(new Lexer(this))
     , parser(new Parser)
-    , interpreter(new Interpreter)
+    , interpreter(new Interpreter(stackLimits[threadStackType].registerFileCapacity)) // FYWEBKITMOD
     , heap(this)
     , head(0)
     , dynamicGlobalObject(0)
@@ -144,7 +167,7 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
     , markStack(jsArrayVPtr)
     , cachedUTCOffset(NaN)
     , weakRandom(static_cast<int>(currentTime()))
-    , maxReentryDepth(threadStackType == ThreadStackTypeSmall ? MaxSmallThreadReentryDepth : MaxLargeThreadReentryDepth)
+    , maxReentryDepth(stackLimits[threadStackType].maxReentryDepth) // FYWEBKITMOD
     , m_regExpCache(new RegExpCache(this))
 #ifndef NDEBUG
     , exclusiveThread(0)
@@ -278,10 +301,25 @@ JSGlobalData::ClientData::~ClientData()
 {
 }
 
+/* FYWEBKITMOD BEGIN */
+void JSGlobalData::registerTypedArrayDescriptor(const TypedArrayDescriptor& descriptor)
+{
+    if (typedArrayDescriptor(descriptor.m_vptr))
+        return;
+    ASSERT(typedArrayDescriptorCount < TypedArrayTypeCount);
+    if (typedArrayDescriptorCount < TypedArrayTypeCount)
+        typedArrayDescriptors[typedArrayDescriptorCount++] = descriptor;
+}
+/* FYWEBKITMOD END */
+
 void JSGlobalData::resetDateCache()
 {
     cachedUTCOffset = NaN;
     dstOffsetCache.reset();
+    /* FYWEBKITMOD BEGIN */
+    dstOffsetDayCache.reset();
+    gregorianDayCache.reset();
+    /* FYWEBKITMOD END */
     cachedDateString = UString();
     dateInstanceCache.reset();
 }
@@ -38,11 +38,13 @@
 #include "ExecutableAllocator.h"
 #include "JITStubs.h"
 #include "JSValue.h"
+#include "LocalTimeCache.h" // FYWEBKITMOD
 #include "MarkStack.h"
 #include "NumericStrings.h"
 #include "SmallStrings.h"
 #include "Terminator.h"
 #include "TimeoutChecker.h"
+#include "TypedArrayDescriptor.h" // FYWEBKITMOD
 #include "WeakRandom.h"
 #include <wtf/Forward.h>
 #include <wtf/HashMap.h>
@@ -120,6 +122,22 @@ namespace JSC {
         static PassRefPtr<JSGlobalData> createContextGroup(ThreadStackType);
         ~JSGlobalData();
 
+        /* FYWEBKITMOD BEGIN */
+        // Hard limits of the JS stack, taken by every JSGlobalData created afterwards for
+        // the given thread stack type. registerFileCapacity is counted in registers and
+        // rounded up to whole blocks of 8192; where the system can't commit memory on
+        // demand, all of it is allocated when the JSGlobalData is created. maxReentryDepth
+        // limits nested calls from native code back into JS (array callbacks, accessors,
+        // event handlers), each of which takes native stack; it is at least
+        // MaxSmallThreadReentryDepth.
+        struct StackLimits {
+            size_t registerFileCapacity;
+            int maxReentryDepth;
+        };
+        static StackLimits defaultStackLimits(ThreadStackType);
+        static void setDefaultStackLimits(ThreadStackType, const StackLimits&);
+        /* FYWEBKITMOD END */
+
 #if ENABLE(JSC_MULTIPLE_THREADS)
         // Will start tracking threads that use the heap, which is resource-heavy.
         void makeUsableFromMultipleThreads() { heap.makeUsableFromMultipleThreads(); }
@@ -159,6 +177,21 @@ namespace JSC {
         static JS_EXPORTDATA void* jsStringVPtr;
         static JS_EXPORTDATA void* jsFunctionVPtr;
 
+        /* FYWEBKITMOD BEGIN */
+        void registerTypedArrayDescriptor(const TypedArrayDescriptor&);
+        const TypedArrayDescriptor* typedArrayDescriptor(void* vptr) const
+        {
+            for (unsigned i = 0; i < typedArrayDescriptorCount; ++i) {
+                if (typedArrayDescriptors[i].m_vptr == vptr)
+                    return &typedArrayDescriptors[i];
+            }
+            return 0;
+        }
+
+        TypedArrayDescriptor typedArrayDescriptors[TypedArrayTypeCount];
+        unsigned typedArrayDescriptorCount;
+        /* FYWEBKITMOD END */
+
         IdentifierTable* identifierTable;
         CommonIdentifiers* propertyNames;
         const MarkedArgumentBuffer* emptyList; // Lists are supposed to be allocated on the stack to have their elements properly marked, which is not the case here - but this list has nothing to mark.
@@ -212,6 +245,10 @@ namespace JSC {
 
         double cachedUTCOffset;
         DSTOffsetCache dstOffsetCache;
+        /* FYWEBKITMOD BEGIN */
+        DSTOffsetDayCache dstOffsetDayCache;
+        GregorianDayCache gregorianDayCache;
+        /* FYWEBKITMOD END */
 
         UString cachedDateString;
         double cachedDateStringValue;
@@ -547,6 +547,14 @@ Structure* JSObject::createInheritorID()
     return m_inheritorID.get();
 }
 
+/* FYWEBKITMOD BEGIN */
+Structure* JSObject::createInheritorID(size_t propertyStorageSize)
+{
+    m_inheritorID = Structure::createWithPropertyStorageCapacity(this, TypeInfo(ObjectType, StructureFlags), AnonymousSlotCount, propertyStorageSize);
+    return m_inheritorID.get();
+}
+/* FYWEBKITMOD END */
+
 void JSObject::allocatePropertyStorage(size_t oldSize, size_t newSize)
 {
     allocatePropertyStorageInline(oldSize, newSize);
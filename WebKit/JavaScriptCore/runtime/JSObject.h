@@ -95,6 +95,7 @@ namespace JSC {
 
         void setStructure(NonNullPassRefPtr<Structure>);
         Structure* inheritorID();
+        Structure* inheritorID(size_t propertyStorageSize); // FYWEBKITMOD
 
         virtual UString className() const;
 
@@ -173,6 +174,7 @@ namespace JSC {
         }
 
         void transitionTo(Structure*);
+        void transitionToLiteralStructure(Structure*); // FYWEBKITMOD
 
         void removeDirect(const Identifier& propertyName);
         bool hasCustomProperties() { return !m_structure->isEmpty(); }
@@ -276,6 +278,7 @@ namespace JSC {
 
         const HashEntry* findPropertyHashEntry(ExecState*, const Identifier& propertyName) const;
         Structure* createInheritorID();
+        Structure* createInheritorID(size_t propertyStorageSize); // FYWEBKITMOD
 
         union {
             PropertyStorage m_externalStorage;
@@ -299,12 +302,17 @@ inline JSObject* asObject(JSValue value)
 inline JSObject::JSObject(NonNullPassRefPtr<Structure> structure)
     : JSCell(structure.releaseRef()) // ~JSObject balances this ref()
 {
-    ASSERT(m_structure->propertyStorageCapacity() == inlineStorageCapacity);
+    ASSERT(m_structure->propertyStorageCapacity() >= inlineStorageCapacity); // FYWEBKITMOD
     ASSERT(m_structure->isEmpty());
     ASSERT(prototype().isNull() || Heap::heap(this) == Heap::heap(prototype()));
 #if USE(JSVALUE64) || USE(JSVALUE32_64)
     ASSERT(OBJECT_OFFSETOF(JSObject, m_inlineStorage) % sizeof(double) == 0);
 #endif
+    /* FYWEBKITMOD BEGIN */
+    // See Structure::createWithPropertyStorageCapacity().
+    if (!isUsingInlineStorage())
+        m_externalStorage = new EncodedJSValue[m_structure->propertyStorageCapacity()];
+    /* FYWEBKITMOD END */
 }
 
 inline JSObject::~JSObject()
@@ -353,6 +361,17 @@ inline Structure* JSObject::inheritorID()
     return createInheritorID();
 }
 
+/* FYWEBKITMOD BEGIN */
+// The inheritor structure, replaced by one with more room if objects inheriting from this one
+// are expected to get more properties than it has room for.
+inline Structure* JSObject::inheritorID(size_t propertyStorageSize)
+{
+    if (m_inheritorID && propertyStorageSize <= m_inheritorID->propertyStorageCapacity())
+        return m_inheritorID.get();
+    return createInheritorID(propertyStorageSize);
+}
+/* FYWEBKITMOD END */
+
 inline bool Structure::isUsingInlineStorage() const
 {
     return (propertyStorageCapacity() == JSObject::inlineStorageCapacity);
@@ -635,6 +654,19 @@ inline void JSObject::transitionTo(Structure* newStructure)
     setStructure(newStructure);
 }
 
+/* FYWEBKITMOD BEGIN */
+// Gives an empty object all properties of an object literal at once, set to undefined, so
+// that the puts filling in the literal replace values instead of adding properties.
+inline void JSObject::transitionToLiteralStructure(Structure* newStructure)
+{
+    ASSERT(m_structure->isEmpty());
+    transitionTo(newStructure);
+    PropertyStorage storage = propertyStorage();
+    for (size_t i = 0; i < newStructure->propertyStorageSize(); ++i)
+        storage[i] = JSValue::encode(jsUndefined());
+}
+/* FYWEBKITMOD END */
+
 inline JSValue JSObject::toPrimitive(ExecState* exec, PreferredPrimitiveType preferredType) const
 {
     return defaultValue(exec, preferredType);
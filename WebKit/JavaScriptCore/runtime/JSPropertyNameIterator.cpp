@@ -29,6 +29,7 @@
 #include "config.h"
 #include "JSPropertyNameIterator.h"
 
+#include "JSArray.h" // FYWEBKITMOD
 #include "JSGlobalObject.h"
 
 namespace JSC {
@@ -41,6 +42,7 @@ inline JSPropertyNameIterator::JSPropertyNameIterator(ExecState* exec, PropertyN
     , m_numCacheableSlots(numCacheableSlots)
     , m_jsStringsSize(propertyNameArrayData->propertyNameVector().size())
     , m_jsStrings(new JSValue[m_jsStringsSize])
+    , m_indexedLength(0) // FYWEBKITMOD
 {
     PropertyNameArrayData::PropertyNameVector& propertyNameVector = propertyNameArrayData->propertyNameVector();
     for (size_t i = 0; i < m_jsStringsSize; ++i)
@@ -59,6 +61,16 @@ JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject
             o->structure()->enumerationCache()->cachedStructure() != o->structure() ||
             o->structure()->enumerationCache()->cachedPrototypeChain() != o->structure()->prototypeChain(exec));
 
+    /* FYWEBKITMOD BEGIN */
+    ++statistics().misses;
+#if !ENABLE(JIT)
+    if (isJSArray(&exec->globalData(), o)) {
+        if (JSPropertyNameIterator* jsPropertyNameIterator = createIndexed(exec, asArray(o)))
+            return jsPropertyNameIterator;
+    }
+#endif
+    /* FYWEBKITMOD END */
+
     PropertyNameArray propertyNames(exec);
     o->getPropertyNames(exec, propertyNames);
     size_t numCacheableSlots = 0;
@@ -69,8 +81,9 @@ JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject
 
     JSPropertyNameIterator* jsPropertyNameIterator = new (exec) JSPropertyNameIterator(exec, propertyNames.data(), numCacheableSlots);
 
-    if (o->structure()->isDictionary())
-        return jsPropertyNameIterator;
+    // FYWEBKITMOD: dictionaries are cached too. Their Structure belongs to the object
+    // alone and drops the iterator whenever its properties change, see
+    // Structure::invalidateEnumerationCache().
 
     if (o->structure()->typeInfo().overridesGetPropertyNames())
         return jsPropertyNameIterator;
@@ -89,8 +102,64 @@ JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject
     return jsPropertyNameIterator;
 }
 
+/* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+// Enumerates the vector of an array by index, the names are only made as the loop gets
+// to them. Arrays with sparse values, and prototypes with index-like names, get the
+// generic iterator. The JIT reads the names straight out of m_jsStrings, so this is only
+// done by the interpreter.
+JSPropertyNameIterator* JSPropertyNameIterator::createIndexed(ExecState* exec, JSArray* array)
+{
+    if (array->hasSparseValues())
+        return 0;
+
+    PropertyNameArray propertyNames(exec);
+    array->JSObject::getOwnPropertyNames(exec, propertyNames);
+    JSValue prototype = array->prototype();
+    if (prototype.isObject())
+        asObject(prototype)->getPropertyNames(exec, propertyNames);
+
+    PropertyNameArrayData::PropertyNameVector& propertyNameVector = propertyNames.data()->propertyNameVector();
+    for (size_t i = 0; i < propertyNameVector.size(); ++i) {
+        bool isArrayIndex;
+        propertyNameVector[i].toArrayIndex(&isArrayIndex);
+        if (isArrayIndex)
+            return 0;
+    }
+
+    JSPropertyNameIterator* jsPropertyNameIterator = new (exec) JSPropertyNameIterator(exec, propertyNames.data(), 0);
+    jsPropertyNameIterator->m_indexedLength = array->usedVectorLength();
+    ++statistics().indexed;
+    return jsPropertyNameIterator;
+}
+#endif
+
+void JSPropertyNameIterator::invalidate()
+{
+    ASSERT(m_cachedStructure);
+    m_cachedStructure->clearEnumerationCache(this);
+    m_cachedStructure = 0;
+}
+
+EnumerationCacheStatistics& JSPropertyNameIterator::statistics()
+{
+    DEFINE_STATIC_LOCAL(EnumerationCacheStatistics, statistics, ());
+    return statistics;
+}
+/* FYWEBKITMOD END */
+
 JSValue JSPropertyNameIterator::get(ExecState* exec, JSObject* base, size_t i)
 {
+    /* FYWEBKITMOD BEGIN */
+    if (i < m_indexedLength) {
+        ASSERT(isJSArray(&exec->globalData(), base));
+        if (!asArray(base)->canGetIndex(i) && !base->hasProperty(exec, static_cast<unsigned>(i)))
+            return JSValue();
+        return jsString(exec, exec->globalData().numericStrings.add(static_cast<unsigned>(i)));
+    }
+    i -= m_indexedLength;
+    /* FYWEBKITMOD END */
+
     JSValue& identifier = m_jsStrings[i];
     if (m_cachedStructure == base->structure() && m_cachedPrototypeChain == base->structure()->prototypeChain(exec))
         return identifier;
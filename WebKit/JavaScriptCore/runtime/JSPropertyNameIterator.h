@@ -37,8 +37,20 @@
 namespace JSC {
 
     class Identifier;
+    class JSArray; // FYWEBKITMOD
     class JSObject;
 
+    /* FYWEBKITMOD BEGIN */
+    struct EnumerationCacheStatistics {
+        EnumerationCacheStatistics() : hits(0), dictionaryHits(0), misses(0), indexed(0) { }
+
+        unsigned hits; // for-in loops that reused the iterator cached on the Structure
+        unsigned dictionaryHits; // of those, loops over dictionary objects
+        unsigned misses; // iterators built from the property names
+        unsigned indexed; // of those, over the indices of an array without string names
+    };
+    /* FYWEBKITMOD END */
+
     class JSPropertyNameIterator : public JSCell {
         friend class JIT;
 
@@ -65,7 +77,7 @@ namespace JSC {
         }
 
         JSValue get(ExecState*, JSObject*, size_t i);
-        size_t size() { return m_jsStringsSize; }
+        size_t size() { return m_indexedLength + m_jsStringsSize; } // FYWEBKITMOD
 
         void setCachedStructure(Structure* structure)
         {
@@ -78,19 +90,44 @@ namespace JSC {
         void setCachedPrototypeChain(NonNullPassRefPtr<StructureChain> cachedPrototypeChain) { m_cachedPrototypeChain = cachedPrototypeChain; }
         StructureChain* cachedPrototypeChain() { return m_cachedPrototypeChain.get(); }
 
+        /* FYWEBKITMOD BEGIN */
+        // Called by the cached Structure when its properties changed in place.
+        void invalidate();
+
+        // The first indexedLength() names are the indices of the array being enumerated.
+        size_t indexedLength() const { return m_indexedLength; }
+
+        static EnumerationCacheStatistics& statistics();
+        static void recordCacheHit(Structure* structure)
+        {
+            ++statistics().hits;
+            if (structure->isDictionary())
+                ++statistics().dictionaryHits;
+        }
+        /* FYWEBKITMOD END */
+
     private:
         JSPropertyNameIterator(ExecState*, PropertyNameArrayData* propertyNameArrayData, size_t numCacheableSlot);
+        /* FYWEBKITMOD BEGIN */
+#if !ENABLE(JIT)
+        static JSPropertyNameIterator* createIndexed(ExecState*, JSArray*);
+#endif
+        /* FYWEBKITMOD END */
 
         RefPtr<Structure> m_cachedStructure;
         RefPtr<StructureChain> m_cachedPrototypeChain;
         uint32_t m_numCacheableSlots;
         uint32_t m_jsStringsSize;
         OwnArrayPtr<JSValue> m_jsStrings;
+        uint32_t m_indexedLength; // FYWEBKITMOD
     };
 
     inline void Structure::setEnumerationCache(JSPropertyNameIterator* enumerationCache)
     {
-        ASSERT(!isDictionary());
+        // FYWEBKITMOD: dictionaries are cached as well, see invalidateEnumerationCache().
+        // The iterator replaced here may still be in use by a loop and must not vouch for
+        // this Structure anymore either, it would miss the next in place change.
+        invalidateEnumerationCache();
         m_enumerationCache = enumerationCache;
     }
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LocalTimeCache_h
+#define LocalTimeCache_h
+
+#include <wtf/FixedArray.h>
+#include <wtf/HashFunctions.h>
+
+namespace JSC {
+
+    extern const double NaN;
+
+    // DSTOffsetCache remembers one interval and starts over whenever a time falls outside
+    // of it, which happens all the time when a page converts times spread over a few days
+    // in no particular order. These caches are keyed by day instead: one entry per day
+    // that was looked at, whatever order the days come in.
+
+    // DST offset of each day, for days on which the offset does not change. A day with a
+    // change is stored with a NaN offset and goes through DSTOffsetCache.
+    class DSTOffsetDayCache {
+    public:
+        DSTOffsetDayCache()
+        {
+            reset();
+        }
+
+        void reset()
+        {
+            for (size_t i = 0; i < cacheSize; ++i)
+                m_cache[i].day = NaN;
+        }
+
+        struct Entry {
+            double day;
+            double offset;
+        };
+
+        Entry& lookup(double day) { return m_cache[WTF::FloatHash<double>::hash(day) & (cacheSize - 1)]; }
+
+    private:
+        static const size_t cacheSize = 64;
+
+        FixedArray<Entry, cacheSize> m_cache;
+    };
+
+    // Calendar fields of a day, so that decomposing times that fall on a day seen before
+    // only has to work out the time of day.
+    class GregorianDayCache {
+    public:
+        GregorianDayCache()
+        {
+            reset();
+        }
+
+        void reset()
+        {
+            for (size_t i = 0; i < cacheSize; ++i)
+                m_cache[i].day = NaN;
+        }
+
+        struct Entry {
+            double day;
+            int year;
+            int yearDay;
+            int month;
+            int monthDay;
+            int weekDay;
+        };
+
+        Entry& lookup(double day) { return m_cache[WTF::FloatHash<double>::hash(day) & (cacheSize - 1)]; }
+
+    private:
+        static const size_t cacheSize = 32;
+
+        FixedArray<Entry, cacheSize> m_cache;
+    };
+
+} // namespace JSC
+
+#endif // LocalTimeCache_h
@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <wtf/ASCIICType.h> // FYWEBKITMOD
 #include <wtf/Assertions.h>
 #include <wtf/OwnArrayPtr.h>
 
@@ -46,6 +47,46 @@
 
 namespace JSC {
 
+/* FYWEBKITMOD BEGIN */
+// The characters of a pattern without metacharacters, or a null string. An escaped
+// punctuation character like \. stands for itself; any other escape is a character class
+// or control character and makes the pattern not a literal.
+static UString literalPattern(const UString& pattern)
+{
+    if (pattern.isEmpty())
+        return UString();
+
+    Vector<UChar, 32> characters;
+    const UChar* end = pattern.data() + pattern.size();
+    for (const UChar* p = pattern.data(); p < end; ++p) {
+        UChar c = *p;
+        switch (c) {
+        case '^':
+        case '$':
+        case '.':
+        case '*':
+        case '+':
+        case '?':
+        case '(':
+        case ')':
+        case '[':
+        case ']':
+        case '{':
+        case '}':
+        case '|':
+            return UString();
+        case '\\':
+            if (++p == end || isASCIIAlphanumeric(*p))
+                return UString();
+            c = *p;
+            break;
+        }
+        characters.append(c);
+    }
+    return UString(characters.data(), characters.size());
+}
+/* FYWEBKITMOD END */
+
 inline RegExp::RegExp(JSGlobalData* globalData, const UString& pattern, const UString& flags)
     : m_pattern(pattern)
     , m_flagBits(0)
@@ -64,6 +105,8 @@ inline RegExp::RegExp(JSGlobalData* globalData, const UString& pattern, const US
             m_flagBits |= Multiline;
     }
     compile(globalData);
+    if (!ignoreCase()) // FYWEBKITMOD
+        m_literal = literalPattern(pattern); // FYWEBKITMOD
 }
 
 #if !ENABLE(YARR)
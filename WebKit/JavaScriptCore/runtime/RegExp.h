@@ -54,6 +54,10 @@ namespace JSC {
         int match(const UString&, int startOffset, Vector<int, 32>* ovector = 0);
         unsigned numSubpatterns() const { return m_numSubpatterns; }
 
+        // FYWEBKITMOD The characters the pattern matches if it has no metacharacters and no
+        // ignoreCase flag, a null string otherwise.
+        const UString& literal() const { return m_literal; }
+
     private:
         RegExp(JSGlobalData* globalData, const UString& pattern, const UString& flags);
 
@@ -68,6 +72,7 @@ namespace JSC {
         UString m_lastMatchString;
         int m_lastMatchStart;
         Vector<int, 32> m_lastOVector;
+        UString m_literal; // FYWEBKITMOD
 
 #if ENABLE(YARR_JIT)
         Yarr::RegexCodeBlock m_regExpJITCode;
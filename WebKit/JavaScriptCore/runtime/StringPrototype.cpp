@@ -288,6 +288,86 @@ static ALWAYS_INLINE JSValue jsSpliceSubstringsWithSeparators(ExecState* exec, J
     return jsString(exec, impl);
 }
 
+/* FYWEBKITMOD BEGIN */
+// Replaces the first or every occurrence of a literal string with a replacement that has
+// no '$' patterns, without a regular expression match per occurrence. The result is
+// written into a single buffer of the final size. lastMatchStart is set to the start of
+// the last occurrence replaced, or UString::NotFound.
+static JSValue replaceLiteral(ExecState* exec, JSString* sourceVal, const UString& source, const UString& literal, const UString& replacement, bool global, unsigned& lastMatchStart)
+{
+    ASSERT(!literal.isEmpty());
+
+    Vector<unsigned, 16> matchStarts;
+    unsigned position = 0;
+    unsigned matchStart;
+    while ((matchStart = source.find(literal, position)) != UString::NotFound) {
+        matchStarts.append(matchStart);
+        position = matchStart + literal.size();
+        if (!global)
+            break;
+    }
+
+    if (matchStarts.isEmpty()) {
+        lastMatchStart = UString::NotFound;
+        return sourceVal;
+    }
+    lastMatchStart = matchStarts.last();
+
+    double totalLength = static_cast<double>(source.size()) + static_cast<double>(matchStarts.size()) * (static_cast<double>(replacement.size()) - literal.size());
+    if (!totalLength)
+        return jsEmptyString(exec);
+    if (totalLength > static_cast<double>(std::numeric_limits<int>::max()))
+        return throwOutOfMemoryError(exec);
+
+    UChar* buffer;
+    PassRefPtr<UStringImpl> impl = UStringImpl::tryCreateUninitialized(static_cast<unsigned>(totalLength), buffer);
+    if (!impl)
+        return throwOutOfMemoryError(exec);
+
+    unsigned sourcePosition = 0;
+    for (size_t i = 0; i < matchStarts.size(); ++i) {
+        UStringImpl::copyChars(buffer, source.data() + sourcePosition, matchStarts[i] - sourcePosition);
+        buffer += matchStarts[i] - sourcePosition;
+        UStringImpl::copyChars(buffer, replacement.data(), replacement.size());
+        buffer += replacement.size();
+        sourcePosition = matchStarts[i] + literal.size();
+    }
+    UStringImpl::copyChars(buffer, source.data() + sourcePosition, source.size() - sourcePosition);
+
+    return jsString(exec, impl);
+}
+
+// Splits at every occurrence of a non-empty separator. The pieces are found first so that
+// the array is created at its final length instead of growing with each put().
+static JSArray* splitAtSeparator(ExecState* exec, const UString& source, const UString& separator, unsigned limit)
+{
+    ASSERT(!separator.isEmpty());
+
+    Vector<StringRange, 16> pieces;
+    unsigned position = 0;
+    unsigned separatorStart;
+    while (pieces.size() != limit) {
+        separatorStart = separator.size() == 1 ? source.find(separator[0], position) : source.find(separator, position);
+        if (separatorStart == UString::NotFound) {
+            pieces.append(StringRange(position, source.size() - position));
+            break;
+        }
+        pieces.append(StringRange(position, separatorStart - position));
+        position = separatorStart + separator.size();
+    }
+
+    JSArray* result = new (exec) JSArray(exec->lexicalGlobalObject()->arrayStructure(), pieces.size(), CreateInitialized);
+    for (unsigned i = 0; i < pieces.size(); ++i) {
+        JSValue piece = jsSubstring(exec, source, pieces[i].position, pieces[i].length);
+        if (result->canSetIndex(i))
+            result->setIndex(i, piece);
+        else
+            result->put(exec, i, piece);
+    }
+    return result;
+}
+/* FYWEBKITMOD END */
+
 EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
@@ -310,6 +390,21 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
 
         RegExpConstructor* regExpConstructor = exec->lexicalGlobalObject()->regExpConstructor();
 
+        /* FYWEBKITMOD BEGIN */
+        // Patterns without metacharacters, like /&/g, are searched for as strings. Matching
+        // the last occurrence once sets RegExp.lastMatch and friends as the loop below would.
+        if (callType == CallTypeNone && !reg->literal().isNull() && replacementString.find('$') == UString::NotFound) {
+            unsigned lastMatchStart;
+            JSValue result = replaceLiteral(exec, sourceVal, source, reg->literal(), replacementString, global, lastMatchStart);
+            if (lastMatchStart != UString::NotFound) {
+                int matchIndex;
+                int matchLen;
+                regExpConstructor->performMatch(reg, source, lastMatchStart, matchIndex, matchLen);
+            }
+            return JSValue::encode(result);
+        }
+        /* FYWEBKITMOD END */
+
         int lastIndex = 0;
         unsigned startPosition = 0;
 
@@ -705,10 +800,22 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSplit(ExecState* exec)
     JSValue a0 = exec->argument(0);
     JSValue a1 = exec->argument(1);
 
+    unsigned limit = a1.isUndefined() ? 0xFFFFFFFFU : a1.toUInt32(exec);
+
+    /* FYWEBKITMOD BEGIN */
+    // Separators that are strings, or regular expressions without metacharacters like /,/.
+    UString separator;
+    if (a0.inherits(&RegExpObject::info))
+        separator = asRegExpObject(a0)->regExp()->literal();
+    else
+        separator = a0.toString(exec);
+    if (!separator.isEmpty() && limit)
+        return JSValue::encode(splitAtSeparator(exec, s, separator, limit));
+    /* FYWEBKITMOD END */
+
     JSArray* result = constructEmptyArray(exec);
     unsigned i = 0;
     unsigned p0 = 0;
-    unsigned limit = a1.isUndefined() ? 0xFFFFFFFFU : a1.toUInt32(exec);
     if (a0.inherits(&RegExpObject::info)) {
         RegExp* reg = asRegExpObject(a0)->regExp();
         if (s.isEmpty() && reg->match(s, 0) >= 0) {
@@ -736,7 +843,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSplit(ExecState* exec)
             }
         }
     } else {
-        UString u2 = a0.toString(exec);
+        UString u2 = separator; // FYWEBKITMOD converted above
         if (u2.isEmpty()) {
             if (s.isEmpty()) {
                 // empty separator matches empty string -> empty array
@@ -607,6 +607,49 @@ PassRefPtr<Structure> Structure::getterSetterTransition(Structure* structure)
     return transition.release();
 }
 
+/* FYWEBKITMOD BEGIN */
+PassRefPtr<Structure> Structure::createWithPropertyStorageCapacity(JSValue prototype, const TypeInfo& typeInfo, unsigned anonymousSlotCount, size_t propertyStorageSize)
+{
+    RefPtr<Structure> structure = create(prototype, typeInfo, anonymousSlotCount);
+    if (propertyStorageSize > structure->m_propertyStorageCapacity)
+        structure->m_propertyStorageCapacity = propertyStorageSize;
+    return structure.release();
+}
+
+PassRefPtr<Structure> Structure::despecifiedCopy(Structure* structure)
+{
+    RefPtr<Structure> copy = create(structure->storedPrototype(), structure->typeInfo(), structure->anonymousSlotCount());
+    copy->m_propertyStorageCapacity = structure->m_propertyStorageCapacity;
+    copy->m_hasGetterSetterProperties = structure->m_hasGetterSetterProperties;
+    copy->m_hasNonEnumerableProperties = structure->m_hasNonEnumerableProperties;
+    copy->m_specificFunctionThrashCount = structure->m_specificFunctionThrashCount;
+
+    // Don't set m_offset, as one can not transition to this.
+
+    structure->materializePropertyMapIfNecessary();
+    copy->m_propertyTable = structure->copyPropertyTable();
+    copy->m_isPinnedPropertyTable = true;
+    copy->despecifyAllFunctions();
+
+    ASSERT(structure->anonymousSlotCount() == copy->anonymousSlotCount());
+    return copy.release();
+}
+
+bool Structure::hasSpecificFunctions()
+{
+    materializePropertyMapIfNecessary();
+    if (!m_propertyTable)
+        return false;
+
+    unsigned entryCount = m_propertyTable->keyCount + m_propertyTable->deletedSentinelCount;
+    for (unsigned i = 1; i <= entryCount; ++i) {
+        if (m_propertyTable->entries()[i].specificValue)
+            return true;
+    }
+    return false;
+}
+/* FYWEBKITMOD END */
+
 PassRefPtr<Structure> Structure::toDictionaryTransition(Structure* structure, DictionaryKind kind)
 {
     ASSERT(!structure->isUncacheableDictionary());
@@ -639,6 +682,7 @@ PassRefPtr<Structure> Structure::toUncacheableDictionaryTransition(Structure* st
 PassRefPtr<Structure> Structure::flattenDictionaryStructure(JSObject* object)
 {
     ASSERT(isDictionary());
+    invalidateEnumerationCache(); // FYWEBKITMOD
     if (isUncacheableDictionary()) {
         ASSERT(m_propertyTable);
         Vector<PropertyMapEntry*> sortedPropertyEntries(m_propertyTable->keyCount);
@@ -679,9 +723,22 @@ PassRefPtr<Structure> Structure::flattenDictionaryStructure(JSObject* object)
     return this;
 }
 
+/* FYWEBKITMOD BEGIN */
+void Structure::invalidateEnumerationCache()
+{
+    // get() hides iterators the last collection didn't mark, e.g. those created since. They
+    // may still be running a loop over the object though; the iterator clears the pointer
+    // when it is destroyed, so it is safe to use as is.
+    if (JSPropertyNameIterator* enumerationCache = m_enumerationCache.getEvenIfUnmarked())
+        enumerationCache->invalidate();
+    ASSERT(!m_enumerationCache.getEvenIfUnmarked());
+}
+/* FYWEBKITMOD END */
+
 size_t Structure::addPropertyWithoutTransition(const Identifier& propertyName, unsigned attributes, JSCell* specificValue)
 {
-    ASSERT(!m_enumerationCache);
+    ASSERT(isDictionary() || !m_enumerationCache); // FYWEBKITMOD
+    invalidateEnumerationCache(); // FYWEBKITMOD
 
     if (m_specificFunctionThrashCount == maxSpecificFunctionThrashCount)
         specificValue = 0;
@@ -700,7 +757,7 @@ size_t Structure::addPropertyWithoutTransition(const Identifier& propertyName, u
 size_t Structure::removePropertyWithoutTransition(const Identifier& propertyName)
 {
     ASSERT(isUncacheableDictionary());
-    ASSERT(!m_enumerationCache);
+    invalidateEnumerationCache(); // FYWEBKITMOD
 
     materializePropertyMapIfNecessary();
 
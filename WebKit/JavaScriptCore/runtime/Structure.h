@@ -82,6 +82,17 @@ namespace JSC {
         static PassRefPtr<Structure> getterSetterTransition(Structure*);
         static PassRefPtr<Structure> toCacheableDictionaryTransition(Structure*);
         static PassRefPtr<Structure> toUncacheableDictionaryTransition(Structure*);
+        /* FYWEBKITMOD BEGIN */
+        // An empty structure whose objects start out with room for propertyStorageSize
+        // properties. Transitions from it keep that capacity.
+        static PassRefPtr<Structure> createWithPropertyStorageCapacity(JSValue prototype, const TypeInfo&, unsigned anonymousSlotCount, size_t propertyStorageSize);
+        // A copy of the structure without specific function values, for objects that get
+        // their properties before the values are known.
+        static PassRefPtr<Structure> despecifiedCopy(Structure*);
+        // Whether a property has a specific function value, i.e. whether objects that get
+        // their properties later need a despecifiedCopy() rather than the structure itself.
+        bool hasSpecificFunctions();
+        /* FYWEBKITMOD END */
 
         PassRefPtr<Structure> flattenDictionaryStructure(JSObject*);
 
@@ -126,7 +137,13 @@ namespace JSC {
         }
 
         bool hasGetterSetterProperties() const { return m_hasGetterSetterProperties; }
-        void setHasGetterSetterProperties(bool hasGetterSetterProperties) { m_hasGetterSetterProperties = hasGetterSetterProperties; }
+        void setHasGetterSetterProperties(bool hasGetterSetterProperties)
+        {
+            // FYWEBKITMOD: a cached iterator may read slots that now hold getters directly.
+            if (hasGetterSetterProperties && !m_hasGetterSetterProperties)
+                invalidateEnumerationCache();
+            m_hasGetterSetterProperties = hasGetterSetterProperties;
+        }
 
         bool hasNonEnumerableProperties() const { return m_hasNonEnumerableProperties; }
 
@@ -141,6 +158,12 @@ namespace JSC {
         void setEnumerationCache(JSPropertyNameIterator* enumerationCache); // Defined in JSPropertyNameIterator.h.
         void clearEnumerationCache(JSPropertyNameIterator* enumerationCache); // Defined in JSPropertyNameIterator.h.
         JSPropertyNameIterator* enumerationCache(); // Defined in JSPropertyNameIterator.h.
+        /* FYWEBKITMOD BEGIN */
+        // Dictionaries change their property table in place instead of transitioning to a
+        // new Structure. Every such change drops the cached iterator, which stops it from
+        // vouching for the names and slots of the object.
+        void invalidateEnumerationCache();
+        /* FYWEBKITMOD END */
         void getPropertyNames(PropertyNameArray&, EnumerationMode mode);
 
     private:
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TypedArrayDescriptor_h
+#define TypedArrayDescriptor_h
+
+#include <stddef.h>
+
+namespace JSC {
+
+    enum TypedArrayType {
+        TypedArrayInt8,
+        TypedArrayUint8,
+        TypedArrayInt16,
+        TypedArrayUint16,
+        TypedArrayInt32,
+        TypedArrayUint32,
+        TypedArrayFloat32,
+        TypedArrayTypeCount
+    };
+
+    // Tells the interpreter how to find the elements of a typed array wrapper class, which
+    // lives outside of JavaScriptCore: objects with the vptr m_vptr hold a pointer to their
+    // implementation object at m_implOffset, and that keeps a pointer to the elements at
+    // m_storageOffset and the element count (an unsigned) at m_lengthOffset. get_by_val and
+    // put_by_val then access elements in range directly instead of going through
+    // getOwnPropertySlot() and put(). Stores convert like the bindings do: integers wrap
+    // around. See JSGlobalData::registerTypedArrayDescriptor().
+    struct TypedArrayDescriptor {
+        TypedArrayDescriptor()
+            : m_vptr(0)
+            , m_type(TypedArrayTypeCount)
+            , m_implOffset(0)
+            , m_storageOffset(0)
+            , m_lengthOffset(0)
+        {
+        }
+
+        TypedArrayDescriptor(void* vptr, TypedArrayType type, ptrdiff_t implOffset, ptrdiff_t storageOffset, ptrdiff_t lengthOffset)
+            : m_vptr(vptr)
+            , m_type(type)
+            , m_implOffset(implOffset)
+            , m_storageOffset(storageOffset)
+            , m_lengthOffset(lengthOffset)
+        {
+        }
+
+        void* m_vptr;
+        TypedArrayType m_type;
+        ptrdiff_t m_implOffset;
+        ptrdiff_t m_storageOffset;
+        ptrdiff_t m_lengthOffset;
+    };
+
+} // namespace JSC
+
+#endif // TypedArrayDescriptor_h
@@ -47,6 +47,12 @@ public:
         return m_ptr;
     }
     
+    /* FYWEBKITMOD BEGIN */
+    // Also returns cells that were not marked by the last collection but are not destroyed
+    // yet. Only safe for owners that the cell clear()s when it is destroyed.
+    T* getEvenIfUnmarked() const { return m_ptr; }
+    /* FYWEBKITMOD END */
+
     bool clear(JSCell* ptr)
     {
         if (ptr == m_ptr) {
@@ -0,0 +1,235 @@
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: NPL 1.1/GPL 2.0/LGPL 2.1
+*
+* The contents of this file are subject to the Netscape Public License
+* Version 1.1 (the "License"); you may not use this file except in
+* compliance with the License. You may obtain a copy of the License at
+* http://www.mozilla.org/NPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is JavaScript Engine testing utilities.
+*
+* The Initial Developer of the Original Code is Netscape Communications Corp.
+* Portions created by the Initial Developer are Copyright (C) 2002
+* the Initial Developer. All Rights Reserved.
+*
+* Contributor(s):
+*
+* Alternatively, the contents of this file may be used under the terms of
+* either the GNU General Public License Version 2 or later (the "GPL"), or
+* the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+* in which case the provisions of the GPL or the LGPL are applicable instead
+* of those above. If you wish to allow use of your version of this file only
+* under the terms of either the GPL or the LGPL, and not to allow others to
+* use your version of this file under the terms of the NPL, indicate your
+* decision by deleting the provisions above and replace them with the notice
+* and other provisions required by the GPL or the LGPL. If you do not delete
+* the provisions above, a recipient may use your version of this file under
+* the terms of any one of the NPL, the GPL or the LGPL.
+*
+* ***** END LICENSE BLOCK *****
+*
+*
+* SUMMARY: for-in over objects in dictionary mode sees deletes and adds
+*
+* Section 12.6.4  The for-in Statement: "Properties of the object being
+* enumerated may be deleted during enumeration. If a property that has not
+* yet been visited during enumeration is deleted, then it will not be
+* visited."
+*
+* Objects with many properties, and objects that had a property deleted,
+* keep their property table in place instead of transitioning to a new
+* shape. The names a for-in loop caches for such an object have to be
+* dropped on every change, whether the change happens between loops or
+* inside one, and also after a garbage collection.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '';
+var summary = 'for-in over dictionary objects sees deletes and adds';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+// More properties than an object takes transitions for, so it is a dictionary.
+function makeDictionary()
+{
+  var obj = {};
+  for (var i = 0; i < 100; i++)
+    obj['p' + i] = i;
+  return obj;
+}
+
+function names(obj)
+{
+  var result = [];
+  for (var name in obj)
+    result.push(name);
+  return result.join();
+}
+
+function collectGarbage()
+{
+  if (typeof gc == 'function')
+    gc();
+}
+
+function expectedNames(count, skip)
+{
+  var result = [];
+  for (var i = 0; i < count; i++)
+  {
+    if (skip.indexOf(i) == -1)
+      result.push('p' + i);
+  }
+  return result.join();
+}
+
+
+
+status = inSection(1);
+var dict = makeDictionary();
+// Twice, so the second loop runs from the cached names.
+names(dict);
+expect = expectedNames(100, []);
+actual = names(dict);
+addThis();
+
+
+
+status = inSection(2);
+delete dict.p5;
+expect = expectedNames(100, [5]);
+actual = names(dict);
+addThis();
+
+
+
+status = inSection(3);
+dict.p100 = 100;
+expect = expectedNames(101, [5]);
+actual = names(dict);
+addThis();
+
+
+
+status = inSection(4);
+collectGarbage();
+names(dict);
+collectGarbage();
+delete dict.p7;
+expect = expectedNames(101, [5, 7]);
+actual = names(dict);
+addThis();
+
+
+
+status = inSection(5);
+// Deleting a property that has not been visited yet from inside the loop.
+names(dict);
+var visited = [];
+for (var name in dict)
+{
+  if (name == 'p10')
+    delete dict.p50;
+  visited.push(name);
+}
+expect = expectedNames(101, [5, 7, 50]);
+actual = visited.join();
+addThis();
+
+
+
+status = inSection(6);
+// Same with a collection between caching the names and the loop.
+names(dict);
+collectGarbage();
+visited = [];
+for (var name in dict)
+{
+  if (name == 'p10')
+    delete dict.p60;
+  visited.push(name);
+}
+expect = expectedNames(101, [5, 7, 50, 60]);
+actual = visited.join();
+addThis();
+
+
+
+status = inSection(7);
+// A loop nested in another one over the same object, deleting in between.
+visited = [];
+for (var outer in dict)
+{
+  if (outer != 'p0')
+    break;
+  delete dict.p1;
+  for (var inner in dict)
+    visited.push(inner);
+}
+expect = expectedNames(101, [1, 5, 7, 50, 60]);
+actual = visited.join();
+addThis();
+
+
+
+status = inSection(8);
+// A small object turns into a dictionary by the delete itself.
+var small = { a: 1, b: 2, c: 3, d: 4 };
+names(small);
+names(small);
+visited = [];
+for (var name in small)
+{
+  if (name == 'a')
+    delete small.c;
+  visited.push(name);
+}
+expect = 'a,b,d';
+actual = visited.join();
+addThis();
+
+status = inSection(9);
+expect = 'a,b,d';
+actual = names(small);
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -565,12 +565,121 @@ static bool parseLong(const char* string, char** stopPosition, int base, long* r
     return true;
 }
 
+/* FYWEBKITMOD BEGIN */
+static bool readDigits(const char*& s, int count, long& result)
+{
+    long value = 0;
+    for (int i = 0; i < count; ++i, ++s) {
+        if (!isASCIIDigit(*s))
+            return false;
+        value = value * 10 + (*s - '0');
+    }
+    result = value;
+    return true;
+}
+
+// Four digit year, or a sign and six digits, followed by the end or a date or time separator.
+static bool looksLikeISODate(const char* dateString)
+{
+    int digits = 4;
+    if (*dateString == '+' || *dateString == '-') {
+        ++dateString;
+        digits = 6;
+    }
+    for (int i = 0; i < digits; ++i) {
+        if (!isASCIIDigit(*dateString++))
+            return false;
+    }
+    return !*dateString || *dateString == '-' || *dateString == 'T';
+}
+
+// Parses the date time string format of ECMA-262 5th edition, section 15.9.1.15:
+//     YYYY[-MM[-DD]][THH:mm[:ss[.sss]]][Z|(+|-)HH:mm]
+// The free form parser below rejects all of these, and they are what JSON and most feeds
+// use. As the specification says, a missing offset means UTC.
+static double parseISODate(const char* dateString, bool& haveTZ, int& offset)
+{
+    long year;
+    if (*dateString == '+' || *dateString == '-') {
+        int sign = *dateString++ == '-' ? -1 : 1;
+        if (!readDigits(dateString, 6, year))
+            return NaN;
+        year *= sign;
+    } else if (!readDigits(dateString, 4, year))
+        return NaN;
+
+    long month = 1;
+    long day = 1;
+    if (*dateString == '-') {
+        ++dateString;
+        if (!readDigits(dateString, 2, month) || month < 1 || month > 12)
+            return NaN;
+        if (*dateString == '-') {
+            ++dateString;
+            bool leapYear = isLeapYear(year);
+            int daysInMonth = month == 12 ? 31 : firstDayOfMonth[leapYear][month] - firstDayOfMonth[leapYear][month - 1];
+            if (!readDigits(dateString, 2, day) || day < 1 || day > daysInMonth)
+                return NaN;
+        }
+    }
+
+    long hour = 0;
+    long minute = 0;
+    long second = 0;
+    long milliseconds = 0;
+    if (*dateString == 'T') {
+        ++dateString;
+        if (!readDigits(dateString, 2, hour) || *dateString++ != ':' || !readDigits(dateString, 2, minute))
+            return NaN;
+        if (*dateString == ':') {
+            ++dateString;
+            if (!readDigits(dateString, 2, second))
+                return NaN;
+            if (*dateString == '.') {
+                ++dateString;
+                if (!isASCIIDigit(*dateString))
+                    return NaN;
+                // Digits beyond milliseconds are ignored.
+                for (long scale = 100; isASCIIDigit(*dateString); ++dateString, scale /= 10)
+                    milliseconds += (*dateString - '0') * scale;
+            }
+        }
+        if (hour > 24 || minute > 59 || second > 59 || (hour == 24 && (minute || second || milliseconds)))
+            return NaN;
+
+        if (*dateString == 'Z')
+            ++dateString;
+        else if (*dateString == '+' || *dateString == '-') {
+            int sign = *dateString++ == '-' ? -1 : 1;
+            long offsetHours;
+            long offsetMinutes;
+            if (!readDigits(dateString, 2, offsetHours) || *dateString++ != ':' || !readDigits(dateString, 2, offsetMinutes))
+                return NaN;
+            if (offsetHours > 23 || offsetMinutes > 59)
+                return NaN;
+            offset = sign * static_cast<int>(offsetHours * 60 + offsetMinutes);
+        }
+    }
+
+    if (*dateString)
+        return NaN;
+
+    haveTZ = true;
+    return dateToDaysFrom1970(year, month - 1, day) * msPerDay + timeToMS(hour, minute, second, milliseconds);
+}
+/* FYWEBKITMOD END */
+
 // Odd case where 'exec' is allowed to be 0, to accomodate a caller in WebCore.
 static double parseDateFromNullTerminatedCharacters(const char* dateString, bool& haveTZ, int& offset)
 {
     haveTZ = false;
     offset = 0;
 
+    /* FYWEBKITMOD BEGIN */
+    if (looksLikeISODate(dateString))
+        return parseISODate(dateString, haveTZ, offset);
+    /* FYWEBKITMOD END */
+
     // This parses a date in the form:
     //     Tuesday, 09-Nov-99 23:12:40 GMT
     // or
@@ -929,6 +1038,31 @@ static double getDSTOffset(ExecState* exec, double ms, double utcOffset)
     return offset;
 }
 
+/* FYWEBKITMOD BEGIN */
+// Get the DST offset through the per-day cache. getDSTOffset() remembers a single interval
+// and has to start over for every time outside of it, which is most of them when times of
+// several days come in no particular order. Days on which the offset changes still go
+// through getDSTOffset(), which narrows down the time of the change.
+static double getDSTOffsetForDay(ExecState* exec, double ms, double utcOffset)
+{
+    double day = floor(ms / WTF::msPerDay);
+    if (!isfinite(day))
+        return getDSTOffset(exec, ms, utcOffset);
+
+    DSTOffsetDayCache::Entry& entry = exec->globalData().dstOffsetDayCache.lookup(day);
+    if (entry.day != day) {
+        double dayStart = day * WTF::msPerDay;
+        double startOffset = calculateDSTOffset(dayStart, utcOffset);
+        double endOffset = calculateDSTOffset(dayStart + WTF::msPerDay - 1, utcOffset);
+        entry.day = day;
+        entry.offset = startOffset == endOffset ? startOffset : NaN;
+    }
+    if (!isnan(entry.offset))
+        return entry.offset;
+    return getDSTOffset(exec, ms, utcOffset);
+}
+/* FYWEBKITMOD END */
+
 /*
  * Get the difference in milliseconds between this time zone and UTC (GMT)
  * NOT including DST.
@@ -951,7 +1085,7 @@ double gregorianDateTimeToMS(ExecState* exec, const GregorianDateTime& t, double
     if (!inputIsUTC) { // convert to UTC
         double utcOffset = getUTCOffset(exec);
         result -= utcOffset;
-        result -= getDSTOffset(exec, result, utcOffset);
+        result -= getDSTOffsetForDay(exec, result, utcOffset); // FYWEBKITMOD
     }
 
     return result;
@@ -964,19 +1098,33 @@ void msToGregorianDateTime(ExecState* exec, double ms, bool outputIsUTC, Gregori
     double utcOff = 0.0;
     if (!outputIsUTC) {
         utcOff = getUTCOffset(exec);
-        dstOff = getDSTOffset(exec, ms, utcOff);
+        dstOff = getDSTOffsetForDay(exec, ms, utcOff); // FYWEBKITMOD
         ms += dstOff + utcOff;
     }
 
-    const int year = msToYear(ms);
+    /* FYWEBKITMOD BEGIN */
+    // The calendar fields only depend on the day, which is usually one seen before.
+    double day = msToDays(ms);
+    GregorianDayCache::Entry& entry = exec->globalData().gregorianDayCache.lookup(day);
+    if (entry.day != day) {
+        const int year = msToYear(ms);
+        entry.day = day;
+        entry.year = year;
+        entry.weekDay = msToWeekDay(ms);
+        entry.yearDay = dayInYear(ms, year);
+        entry.monthDay = dayInMonthFromDayInYear(entry.yearDay, isLeapYear(year));
+        entry.month = monthFromDayInYear(entry.yearDay, isLeapYear(year));
+    }
+
     tm.second   =  msToSeconds(ms);
     tm.minute   =  msToMinutes(ms);
     tm.hour     =  msToHours(ms);
-    tm.weekDay  =  msToWeekDay(ms);
-    tm.yearDay  =  dayInYear(ms, year);
-    tm.monthDay =  dayInMonthFromDayInYear(tm.yearDay, isLeapYear(year));
-    tm.month    =  monthFromDayInYear(tm.yearDay, isLeapYear(year));
-    tm.year     =  year - 1900;
+    tm.weekDay  =  entry.weekDay;
+    tm.yearDay  =  entry.yearDay;
+    tm.monthDay =  entry.monthDay;
+    tm.month    =  entry.month;
+    tm.year     =  entry.year - 1900;
+    /* FYWEBKITMOD END */
     tm.isDST    =  dstOff != 0.0;
     tm.utcOffset = static_cast<long>((dstOff + utcOff) / WTF::msPerSecond);
     tm.timeZone = NULL;
@@ -994,7 +1142,7 @@ double parseDateFromNullTerminatedCharacters(ExecState* exec, const char* dateSt
     // fall back to local timezone
     if (!haveTZ) {
         double utcOffset = getUTCOffset(exec);
-        double dstOffset = getDSTOffset(exec, ms, utcOffset);
+        double dstOffset = getDSTOffsetForDay(exec, ms, utcOffset); // FYWEBKITMOD
         offset = static_cast<int>((utcOffset + dstOffset) / WTF::msPerMinute);
     }
     return ms - (offset * WTF::msPerMinute);
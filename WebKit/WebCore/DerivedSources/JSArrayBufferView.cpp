@@ -32,6 +32,7 @@
 #include <runtime/Error.h>
 #include <runtime/JSNumberCell.h>
 #include <wtf/GetPtr.h>
+#include <wtf/StdLibExtras.h> // FYWEBKITMOD
 
 using namespace JSC;
 
@@ -97,6 +98,15 @@ JSArrayBufferView::JSArrayBufferView(NonNullPassRefPtr<Structure> structure, JSD
 {
 }
 
+/* FYWEBKITMOD BEGIN */
+// Called by the constructor of the final wrapper class, whose vptr is set by then. The
+// offsets are those of the elements and their count in the implementation object.
+void JSArrayBufferView::registerTypedArrayDescriptor(JSGlobalData* globalData, TypedArrayType type, ptrdiff_t storageOffset, ptrdiff_t lengthOffset)
+{
+    globalData->registerTypedArrayDescriptor(TypedArrayDescriptor(vptr(), type, OBJECT_OFFSETOF(JSArrayBufferView, m_impl), storageOffset, lengthOffset));
+}
+/* FYWEBKITMOD END */
+
 JSArrayBufferView::~JSArrayBufferView()
 {
     forgetDOMObject(this, impl());
@@ -59,6 +59,7 @@ private:
     RefPtr<ArrayBufferView> m_impl;
 protected:
     static const unsigned StructureFlags = JSC::OverridesGetOwnPropertySlot | Base::StructureFlags;
+    void registerTypedArrayDescriptor(JSC::JSGlobalData*, JSC::TypedArrayType, ptrdiff_t storageOffset, ptrdiff_t lengthOffset); // FYWEBKITMOD
 };
 
 JSC::JSValue toJS(JSC::ExecState*, JSDOMGlobalObject*, ArrayBufferView*);
@@ -129,6 +129,7 @@ const ClassInfo JSUint8Array::s_info = { "Uint8Array", &JSArrayBufferView::s_inf
 JSUint8Array::JSUint8Array(NonNullPassRefPtr<Structure> structure, JSDOMGlobalObject* globalObject, PassRefPtr<Uint8Array> impl)
     : JSArrayBufferView(structure, globalObject, impl)
 {
+    registerTypedArrayDescriptor(globalObject->globalData(), TypedArrayUint8, Uint8Array::storageOffset(), Uint8Array::lengthOffset()); // FYWEBKITMOD
 }
 
 JSObject* JSUint8Array::createPrototype(ExecState* exec, JSGlobalObject* globalObject)
@@ -426,7 +426,7 @@ JSC::JSValue jsXMLHttpRequestResponse(JSC::ExecState* exec, JSC::JSValue slotBas
     UNUSED_PARAM(exec);
     XMLHttpRequest* imp = static_cast<XMLHttpRequest*>(castedThis->impl());
 
-	if (imp->responseType() == "arraybuffer")
+	if (imp->responseTypeCode() >= XMLHttpRequest::FirstBinaryResponseType)
 		{
         return toJS(exec, castedThis->globalObject(), WTF::getPtr(imp->responseArrayBuffer()));
 		}
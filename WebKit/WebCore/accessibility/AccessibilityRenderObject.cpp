@@ -2494,7 +2494,7 @@ IntRect AccessibilityRenderObject::boundsForVisiblePositionRange(const VisiblePo
     if (rect1.bottom() != rect2.bottom()) {
         RefPtr<Range> dataRange = makeRange(range.start, range.end);
         IntRect boundingBox = dataRange->boundingBox();
-        String rangeString = plainText(dataRange.get());
+        String rangeString = plainTextPrefix(dataRange.get(), 2); // FYWEBKITMOD: only the length matters
         if (rangeString.length() > 1 && !boundingBox.isEmpty())
             ourrect = boundingBox;
     }
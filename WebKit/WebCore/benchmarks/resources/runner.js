@@ -0,0 +1,66 @@
+// Shared by the benchmark pages. Each page has a <pre id="log"> and times its work with
+// measure() or measureAsync(): one warm-up run that is discarded, then runCount timed
+// runs whose average and standard deviation are logged with logStatistics().
+
+function log(text) {
+    document.getElementById("log").innerText += text + "\n";
+}
+
+function computeAverage(values) {
+    var sum = 0;
+    for (var i = 0; i < values.length; i++)
+        sum += values[i];
+    return sum / values.length;
+}
+
+function computeStdev(values) {
+    var average = computeAverage(values);
+    var sumOfSquaredDeviations = 0;
+    for (var i = 0; i < values.length; ++i) {
+        var deviation = values[i] - average;
+        sumOfSquaredDeviations += deviation * deviation;
+    }
+    return Math.sqrt(sumOfSquaredDeviations / values.length);
+}
+
+// Logs "name: avg ... stdev ..." followed by details, if given.
+function logStatistics(name, times, details) {
+    log(name + ": avg " + computeAverage(times) + " stdev " + computeStdev(times) + (details || ""));
+}
+
+// Returns the times of runCount calls of work. setUp, if given, is called before each run
+// and not timed.
+function measure(runCount, work, setUp) {
+    var times = [];
+    for (var completedRuns = -1; completedRuns < runCount; ++completedRuns) { // Run -1 warms up and is discarded.
+        if (setUp)
+            setUp();
+        var start = new Date();
+        work();
+        var time = new Date() - start;
+        if (completedRuns >= 0)
+            times.push(time);
+    }
+    return times;
+}
+
+// For work that finishes asynchronously or has to let the page paint: work is called with
+// a function to call once it is done. Each run is started from a timer, and done is called
+// with the times of all runs.
+function measureAsync(runCount, work, done) {
+    var times = [];
+    var completedRuns = -1; // Run -1 warms up and is discarded.
+    function runOnce() {
+        var start = new Date();
+        work(function() {
+            var time = new Date() - start;
+            if (completedRuns >= 0)
+                times.push(time);
+            if (++completedRuns < runCount)
+                window.setTimeout(runOnce, 0);
+            else
+                done(times);
+        });
+    }
+    runOnce();
+}
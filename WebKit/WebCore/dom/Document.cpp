@@ -120,6 +120,7 @@
 #include "SegmentedString.h"
 #include "SelectionController.h"
 #include "Settings.h"
+#include "SpatialNavigationIndexFymp.h" // FYWEBKITMOD
 #include "StringBuffer.h"
 #include "StyleSheetList.h"
 #include "TextEvent.h"
@@ -359,6 +360,8 @@ private:
 Document::Document(Frame* frame, const KURL& url, bool isXHTML, bool isHTML)
     : ContainerNode(0)
     , m_domtree_version(0)
+    , m_layerScrollCount(0) // FYWEBKITMOD
+    , m_focusableElementsVersion(0) // FYWEBKITMOD
     , m_styleSheets(StyleSheetList::create(this))
     , m_styleRecalcTimer(this, &Document::styleRecalcTimerFired)
     , m_frameElementsShouldIgnoreScrolling(false)
@@ -599,6 +602,15 @@ void Document::resetActiveLinkColor()
     m_activeLinkColor.setNamedColor("red");
 }
 
+/* FYWEBKITMOD BEGIN */
+SpatialNavigationIndexFymp* Document::spatialNavigationIndex()
+{
+    if (!m_spatialNavigationIndex)
+        m_spatialNavigationIndex = adoptPtr(new SpatialNavigationIndexFymp(this));
+    return m_spatialNavigationIndex.get();
+}
+/* FYWEBKITMOD END */
+
 void Document::setDocType(PassRefPtr<DocumentType> docType)
 {
     // This should never be called more than once.
@@ -1625,6 +1637,13 @@ void Document::detach()
     // indicate destruction mode,  i.e. attached() but renderer == 0
     setRenderer(0);
 
+/* FYWEBKITMOD BEGIN */
+    // The arena is released at the end of detach, let the render tree teardown
+    // (which starts with the DOM detach below) skip the per-object bookkeeping.
+    if (render && m_renderArena)
+        m_renderArena->beginBulkTeardown();
+/* FYWEBKITMOD END */
+
     m_hoverNode = 0;
     m_focusedNode = 0;
     m_activeNode = 0;
@@ -3057,6 +3076,8 @@ void Document::detachNodeIterator(NodeIterator *ni)
 
 void Document::nodeChildrenChanged(ContainerNode* container)
 {
+    didChangeFocusableElements(); // FYWEBKITMOD
+
     if (!disableRangeMutation(page())) {
         HashSet<Range*>::const_iterator end = m_ranges.end();
         for (HashSet<Range*>::const_iterator it = m_ranges.begin(); it != end; ++it)
@@ -3066,6 +3087,8 @@ void Document::nodeChildrenChanged(ContainerNode* container)
 
 void Document::nodeChildrenWillBeRemoved(ContainerNode* container)
 {
+    didChangeFocusableElements(); // FYWEBKITMOD
+
     if (!disableRangeMutation(page())) {
         HashSet<Range*>::const_iterator end = m_ranges.end();
         for (HashSet<Range*>::const_iterator it = m_ranges.begin(); it != end; ++it)
@@ -3088,6 +3111,8 @@ void Document::nodeChildrenWillBeRemoved(ContainerNode* container)
 
 void Document::nodeWillBeRemoved(Node* n)
 {
+    didChangeFocusableElements(); // FYWEBKITMOD
+
     HashSet<NodeIterator*>::const_iterator nodeIteratorsEnd = m_nodeIterators.end();
     for (HashSet<NodeIterator*>::const_iterator it = m_nodeIterators.begin(); it != nodeIteratorsEnd; ++it)
         (*it)->nodeWillBeRemoved(n);
@@ -3622,6 +3647,12 @@ void Document::setInPageCache(bool flag)
         if (FrameView* v = view())
             v->resetScrollbars();
         unscheduleStyleRecalc();
+/* FYWEBKITMOD BEGIN */
+        // The render tree is kept alive while in the page cache, but arenas only
+        // holding freed objects can go back to the system.
+        if (m_renderArena)
+            m_renderArena->releaseFreeArenas();
+/* FYWEBKITMOD END */
     } else {
         ASSERT(renderer() == 0 || renderer() == m_savedRenderer);
         ASSERT(m_renderArena);
@@ -108,6 +108,7 @@ namespace WebCore {
     class SerializedScriptValue;
     class SegmentedString;
     class Settings;
+    class SpatialNavigationIndexFymp; // FYWEBKITMOD
     class StyleSheet;
     class StyleSheetList;
     class Text;
@@ -851,6 +852,18 @@ public:
     void incDOMTreeVersion() { ++m_domtree_version; }
     unsigned domTreeVersion() const { return m_domtree_version; }
 
+    /* FYWEBKITMOD BEGIN */
+    // Focusable elements by position, for spatial navigation in this document.
+    SpatialNavigationIndexFymp* spatialNavigationIndex();
+    // Counts scrolls of overflow layers, which move their content without a layout.
+    void didScrollLayer() { ++m_layerScrollCount; }
+    unsigned layerScrollCount() const { return m_layerScrollCount; }
+    // Counts changes to the set of elements that can take the focus: nodes inserted or
+    // removed, and tabindex, disabled, contenteditable or href set or cleared.
+    void didChangeFocusableElements() { ++m_focusableElementsVersion; }
+    unsigned focusableElementsVersion() const { return m_focusableElementsVersion; }
+    /* FYWEBKITMOD END */
+
     void setDocType(PassRefPtr<DocumentType>);
 
 #if ENABLE(XPATH)
@@ -1111,6 +1124,11 @@ private:
     mutable RefPtr<Element> m_documentElement;
 
     unsigned m_domtree_version;
+    /* FYWEBKITMOD BEGIN */
+    unsigned m_layerScrollCount;
+    unsigned m_focusableElementsVersion;
+    OwnPtr<SpatialNavigationIndexFymp> m_spatialNavigationIndex;
+    /* FYWEBKITMOD END */
     
     HashSet<NodeIterator*> m_nodeIterators;
     HashSet<Range*> m_ranges;
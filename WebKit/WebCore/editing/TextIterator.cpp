@@ -40,6 +40,7 @@
 #include "RenderTextControl.h"
 #include "VisiblePosition.h"
 #include "visible_units.h"
+#include <limits> // FYWEBKITMOD
 
 #if USE(ICU_UNICODE) && !UCONFIG_NO_COLLATION
 #include "TextBreakIteratorInternalICU.h"
@@ -2193,23 +2194,79 @@ exit:
     return result;
 }
 
-String plainText(const Range* r)
-{
-    unsigned length;
-    UChar* buf = plainTextToMallocAllocatedBuffer(r, length, false);
-    if (!buf)
-        return "";
-    String result(buf, length);
 /* FYWEBKITMOD BEGIN */
+// Collects the text in segments like plainTextToMallocAllocatedBuffer(), but copies them
+// straight into the characters of the resulting String once the length is known, instead
+// of concatenating them into one more malloc'ed buffer first.
+static String plainTextInternal(const Range* r, unsigned maxLength)
+{
+    // Use system malloc for the segments since they can consume lots of memory and current
+    // TCMalloc is unable return it back to OS.
+    static const unsigned cMaxSegmentSize = 1 << 16;
+    typedef pair<UChar*, unsigned> TextSegment;
+    Vector<TextSegment> textSegments;
+    Vector<UChar> textBuffer;
+    textBuffer.reserveInitialCapacity(min(cMaxSegmentSize, maxLength));
+    unsigned totalLength = 0;
+    bool failed = false;
+    for (TextIterator it(r, TextIteratorEmitsTextsWithoutTranscoding); !it.atEnd(); it.advance()) {
+        unsigned length = min<unsigned>(it.length(), maxLength - totalLength);
+        if (textBuffer.size() && textBuffer.size() + length > cMaxSegmentSize) {
 #if PLATFORM(FYMP)
-    FYMPwebkitGlue::WKfree(buf);
+            UChar* newSegmentBuffer = static_cast<UChar*>(FYMPwebkitGlue::WKmalloc(textBuffer.size() * sizeof(UChar)));
 #else
-/* FYWEBKITMOD END */
-    free(buf);
+            UChar* newSegmentBuffer = static_cast<UChar*>(malloc(textBuffer.size() * sizeof(UChar)));
+#endif
+            if (!newSegmentBuffer) {
+                failed = true;
+                break;
+            }
+            memcpy(newSegmentBuffer, textBuffer.data(), textBuffer.size() * sizeof(UChar));
+            textSegments.append(make_pair(newSegmentBuffer, static_cast<unsigned>(textBuffer.size())));
+            textBuffer.clear();
+        }
+        textBuffer.append(it.characters(), length);
+        totalLength += length;
+        if (totalLength >= maxLength)
+            break;
+    }
+
+    String result;
+    if (!failed && totalLength) {
+        UChar* resultPos;
+        result = String::createUninitialized(totalLength, resultPos);
+        for (size_t i = 0; i < textSegments.size(); ++i) {
+            memcpy(resultPos, textSegments[i].first, textSegments[i].second * sizeof(UChar));
+            resultPos += textSegments[i].second;
+        }
+        memcpy(resultPos, textBuffer.data(), textBuffer.size() * sizeof(UChar));
+    }
+
+    for (size_t i = 0; i < textSegments.size(); ++i)
+#if PLATFORM(FYMP)
+        FYMPwebkitGlue::WKfree(textSegments[i].first);
+#else
+        free(textSegments[i].first);
 #endif
+
+    if (result.isNull())
+        return "";
     return result;
 }
 
+String plainText(const Range* r)
+{
+    return plainTextInternal(r, numeric_limits<unsigned>::max());
+}
+
+String plainTextPrefix(const Range* r, unsigned maxLength)
+{
+    if (!maxLength)
+        return "";
+    return plainTextInternal(r, maxLength);
+}
+/* FYWEBKITMOD END */
+
 static inline bool isAllCollapsibleWhitespace(const String& string)
 {
     const UChar* characters = string.characters();
@@ -46,6 +46,10 @@ inline bool isCollapsibleWhitespace(UChar c)
 }
 
 String plainText(const Range*);
+/* FYWEBKITMOD BEGIN */
+// Stops iterating once maxLength characters have been collected.
+String plainTextPrefix(const Range*, unsigned maxLength);
+/* FYWEBKITMOD END */
 UChar* plainTextToMallocAllocatedBuffer(const Range*, unsigned& bufferLength, bool isDisplayString);
 PassRefPtr<Range> findPlainText(const Range*, const String&, bool forward, bool caseSensitive);
 
@@ -256,8 +256,10 @@ void HTMLAnchorElement::parseMappedAttribute(Attribute* attr)
     if (attr->name() == hrefAttr) {
         bool wasLink = isLink();
         setIsLink(!attr->isNull());
-        if (wasLink != isLink())
+        if (wasLink != isLink()) {
             setNeedsStyleRecalc();
+            document()->didChangeFocusableElements(); // FYWEBKITMOD
+        }
         if (isLink()) {
             String parsedURL = deprecatedParseURL(attr->value());
             if (document()->isDNSPrefetchEnabled()) {
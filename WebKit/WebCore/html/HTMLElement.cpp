@@ -153,7 +153,9 @@ void HTMLElement::parseMappedAttribute(Attribute* attr)
             addCSSProperty(attr, CSSPropertyTextAlign, attr->value());
     } else if (attr->name() == contenteditableAttr) {
         setContentEditable(attr);
+        document()->didChangeFocusableElements(); // FYWEBKITMOD
     } else if (attr->name() == tabindexAttr) {
+        document()->didChangeFocusableElements(); // FYWEBKITMOD
         indexstring = getAttribute(tabindexAttr);
         if (indexstring.length()) {
             bool parsedOK;
@@ -96,6 +96,7 @@ void HTMLFormControlElement::parseMappedAttribute(Attribute* attr)
         m_disabled = !attr->isNull();
         if (oldDisabled != m_disabled) {
             setNeedsStyleRecalc();
+            document()->didChangeFocusableElements(); // FYWEBKITMOD
             if (renderer() && renderer()->style()->hasAppearance())
                 renderer()->theme()->stateChanged(renderer(), EnabledState);
         }
@@ -40,7 +40,7 @@ class ArrayBuffer : public RefCounted<ArrayBuffer> {
     static PassRefPtr<ArrayBuffer> create(ArrayBuffer*);
 /* FYWEBKITMOD BEGIN enabling binary response of XMLHttpRequest */
 	static inline PassRefPtr<ArrayBuffer> create(const void* source, unsigned byteLength);
-/* FYWEBKITMOD BEGIN */
+/* FYWEBKITMOD END */
 
     void* data();
     const void* data() const;
@@ -59,7 +59,9 @@ class ArrayBuffer : public RefCounted<ArrayBuffer> {
 /* FYWEBKITMOD BEGIN enabling binary response of XMLHttpRequest */
 PassRefPtr<ArrayBuffer> ArrayBuffer::create(const void* source, unsigned byteLength)
 {
-	void* data = tryAllocate(byteLength, byteLength);
+	void* data = tryAllocate(byteLength, 1);
+	if (!data)
+		return 0;
 	RefPtr<ArrayBuffer> buf = adoptRef(new ArrayBuffer(data, byteLength));
 	memcpy(buf->data(), source, byteLength);
 
@@ -29,6 +29,7 @@
 
 #include "ArrayBufferView.h"
 #include "ArrayBuffer.h"
+#include <wtf/StdLibExtras.h> // FYWEBKITMOD
 
 namespace WebCore {
 
@@ -50,6 +51,12 @@ class TypedArrayBase : public ArrayBufferView {
         return m_length;
     }
 
+    /* FYWEBKITMOD BEGIN */
+    // Where the elements and their count are, for JSC::TypedArrayDescriptor.
+    static ptrdiff_t storageOffset() { return OBJECT_OFFSETOF(TypedArrayBase<T>, m_baseAddress); }
+    static ptrdiff_t lengthOffset() { return OBJECT_OFFSETOF(TypedArrayBase<T>, m_length); }
+    /* FYWEBKITMOD END */
+
   protected:
     TypedArrayBase(PassRefPtr<ArrayBuffer> buffer, unsigned byteOffset, unsigned length)
         : ArrayBufferView(buffer, byteOffset)
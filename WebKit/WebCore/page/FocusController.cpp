@@ -50,6 +50,7 @@
 #include "SelectionController.h"
 #include "Settings.h"
 #include "SpatialNavigation.h"
+#include "SpatialNavigationIndexFymp.h" // FYWEBKITMOD
 #include "Widget.h"
 
 namespace WebCore {
@@ -304,7 +305,10 @@ bool FocusController::advanceFocusDirectionally(FocusDirection direction, Keyboa
     frame = frame->tree()->top();
 
     FocusCandidate focusCandidate;
-    findFocusableNodeInDirection(frame->document()->firstChild(), focusedNode, direction, event, focusCandidate);
+    /* FYWEBKITMOD BEGIN */
+    if (!frame->document()->spatialNavigationIndex()->findCandidate(focusedNode, direction, event, focusCandidate))
+        findFocusableNodeInDirection(frame->document()->firstChild(), focusedNode, direction, event, focusCandidate);
+    /* FYWEBKITMOD END */
 
     Node* node = focusCandidate.node;
     if (!node || !node->isElementNode()) {
@@ -137,6 +137,8 @@ Settings::Settings(Page* page)
     , m_paginateDuringLayoutEnabled(false)
     , m_dnsPrefetchingEnabled(true)
     , m_memoryInfoEnabled(false)
+    , m_animationFrameClockEnabled(false) // FYWEBKITMOD
+    , m_showOccludedPaintingOverlay(false) // FYWEBKITMOD
 {
     // A Frame may not have been created yet, so we initialize the AtomicString 
     // hash before trying to use it.
@@ -313,6 +313,19 @@ namespace WebCore {
         void setMemoryInfoEnabled(bool flag) { m_memoryInfoEnabled = flag; }
         bool memoryInfoEnabled() const { return m_memoryInfoEnabled; }
 
+/* FYWEBKITMOD BEGIN */
+        // When enabled, running CSS animations and transitions are no longer sampled by
+        // a repeating timer but once per display frame, driven by the embedder through
+        // AnimationController::serviceAnimations().
+        void setAnimationFrameClockEnabled(bool flag) { m_animationFrameClockEnabled = flag; }
+        bool animationFrameClockEnabled() const { return m_animationFrameClockEnabled; }
+
+        // Debug aid: tints areas where painting of layers was skipped because an
+        // opaque layer on top covers them.
+        void setShowOccludedPaintingOverlay(bool flag) { m_showOccludedPaintingOverlay = flag; }
+        bool showOccludedPaintingOverlay() const { return m_showOccludedPaintingOverlay; }
+/* FYWEBKITMOD END */
+
     private:
         Page* m_page;
         
@@ -397,6 +410,8 @@ namespace WebCore {
         bool m_paginateDuringLayoutEnabled : 1;
         bool m_dnsPrefetchingEnabled : 1;
         bool m_memoryInfoEnabled: 1;
+        bool m_animationFrameClockEnabled : 1; // FYWEBKITMOD
+        bool m_showOccludedPaintingOverlay : 1; // FYWEBKITMOD
     
 #if USE(SAFARI_THEME)
         static bool gShouldPaintNativeControls;
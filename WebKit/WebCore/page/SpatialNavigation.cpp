@@ -65,7 +65,12 @@ void distanceDataForNode(FocusDirection direction, Node* start, FocusCandidate&
 
     IntRect curRect = renderRectRelativeToRootDocument(startRender);
     IntRect targetRect  = renderRectRelativeToRootDocument(destRender);
+    distanceDataForRects(direction, start, curRect, targetRect, candidate); // FYWEBKITMOD
+}
 
+/* FYWEBKITMOD BEGIN */
+void distanceDataForRects(FocusDirection direction, Node* start, IntRect curRect, IntRect targetRect, FocusCandidate& candidate)
+{
     // The bounding rectangle of two consecutive nodes can overlap. In such cases,
     // deflate both.
     deflateIfOverlapped(curRect, targetRect);
@@ -99,6 +104,7 @@ void distanceDataForNode(FocusDirection direction, Node* start, FocusCandidate&
     candidate.alignment = alignmentForRects(direction, curRect, targetRect);
     candidate.distance = spatialDistance(direction, curRect, targetRect);
 }
+/* FYWEBKITMOD END */
 
 // FIXME: This function does not behave correctly with transformed frames.
 static IntRect renderRectRelativeToRootDocument(RenderObject* render)
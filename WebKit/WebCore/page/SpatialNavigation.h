@@ -128,6 +128,8 @@ struct FocusCandidate {
 };
 
 void distanceDataForNode(FocusDirection direction, Node* start, FocusCandidate& candidate);
+// FYWEBKITMOD: Rects relative to the root document, as distanceDataForNode() takes them from the renderers.
+void distanceDataForRects(FocusDirection, Node* start, IntRect startRect, IntRect candidateRect, FocusCandidate&);
 bool scrollInDirection(Frame*, FocusDirection, const FocusCandidate& candidate = FocusCandidate());
 void scrollIntoView(Element*);
 bool hasOffscreenRect(Node*);
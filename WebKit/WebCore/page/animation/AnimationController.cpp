@@ -36,6 +36,7 @@
 #include "EventNames.h"
 #include "Frame.h"
 #include "RenderView.h"
+#include "Settings.h"
 #include "WebKitAnimationEvent.h"
 #include "WebKitTransitionEvent.h"
 #include <wtf/CurrentTime.h>
@@ -45,6 +46,7 @@ namespace WebCore {
 
 static const double cAnimationTimerDelay = 0.025;
 static const double cBeginAnimationUpdateTimeNotSet = -1;
+static const double cMaxFrameClockAge = 0.05; // FYWEBKITMOD: two frames at the timer rate
 
 AnimationControllerPrivate::AnimationControllerPrivate(Frame* frame)
     : m_animationTimer(this, &AnimationControllerPrivate::animationTimerFired)
@@ -56,6 +58,8 @@ AnimationControllerPrivate::AnimationControllerPrivate(Frame* frame)
     , m_responseWaiters(0)
     , m_lastResponseWaiter(0)
     , m_waitingForResponse(false)
+    , m_needsFrameService(false) // FYWEBKITMOD
+    , m_frameClockTime(cBeginAnimationUpdateTimeNotSet) // FYWEBKITMOD
 {
 }
 
@@ -112,6 +116,20 @@ void AnimationControllerPrivate::updateAnimationTimer(bool callSetChanged/* = fa
     if (calledSetChanged)
         m_frame->document()->updateStyleIfNeeded();
     
+/* FYWEBKITMOD BEGIN */
+    // With a frame clock the embedder services us on its next display frame instead.
+    bool wasWaitingForFrame = m_needsFrameService;
+    m_needsFrameService = needsService == 0 && usesFrameClock();
+    if (m_needsFrameService) {
+        // The last serviced frame may be long gone, don't sample new animations at it.
+        if (!wasWaitingForFrame)
+            m_frameClockTime = cBeginAnimationUpdateTimeNotSet;
+        if (m_animationTimer.isActive())
+            m_animationTimer.stop();
+        return;
+    }
+/* FYWEBKITMOD END */
+
     // If we want service immediately, we start a repeating timer to reduce the overhead of starting
     if (needsService == 0) {
         if (!m_animationTimer.isActive() || m_animationTimer.repeatInterval() == 0)
@@ -295,6 +313,39 @@ bool AnimationControllerPrivate::pauseTransitionAtTime(RenderObject* renderer, c
     return false;
 }
 
+/* FYWEBKITMOD BEGIN */
+bool AnimationControllerPrivate::usesFrameClock() const
+{
+    Settings* settings = m_frame->settings();
+    return settings && settings->animationFrameClockEnabled();
+}
+
+void AnimationControllerPrivate::beginAnimationUpdate()
+{
+    // Style updates in between two frames sample at the time of the last frame, so that all
+    // animations of a frame agree. Without a running frame clock there is no such frame and
+    // a new animation has to start at the current time. The same goes for a host that
+    // stopped servicing frames, e.g. while the view is hidden.
+    if (m_needsFrameService && usesFrameClock() && currentTime() - m_frameClockTime <= cMaxFrameClockAge)
+        setBeginAnimationUpdateTime(m_frameClockTime);
+    else
+        setBeginAnimationUpdateTime(cBeginAnimationUpdateTimeNotSet);
+}
+
+void AnimationControllerPrivate::serviceAnimations(double frameTime)
+{
+    if (!m_needsFrameService)
+        return;
+
+    m_frameClockTime = frameTime;
+    setBeginAnimationUpdateTime(frameTime);
+
+    // Same as animationTimerFired(), but sampling at the frame time.
+    updateAnimationTimer(true);
+    fireEventsAndUpdateStyle();
+}
+/* FYWEBKITMOD END */
+
 double AnimationControllerPrivate::beginAnimationUpdateTime()
 {
     if (m_beginAnimationUpdateTime == cBeginAnimationUpdateTimeNotSet)
@@ -563,7 +614,7 @@ void AnimationController::resumeAnimations(Document* document)
 
 void AnimationController::beginAnimationUpdate()
 {
-    m_data->setBeginAnimationUpdateTime(cBeginAnimationUpdateTimeNotSet);
+    m_data->beginAnimationUpdate(); // FYWEBKITMOD
 }
 
 void AnimationController::endAnimationUpdate()
@@ -571,6 +622,18 @@ void AnimationController::endAnimationUpdate()
     m_data->endAnimationUpdate();
 }
 
+/* FYWEBKITMOD BEGIN */
+bool AnimationController::needsAnimationFrame() const
+{
+    return m_data->needsFrameService();
+}
+
+void AnimationController::serviceAnimations(double frameTime)
+{
+    m_data->serviceAnimations(frameTime);
+}
+/* FYWEBKITMOD END */
+
 bool AnimationController::supportsAcceleratedAnimationOfProperty(CSSPropertyID property)
 {
 #if USE(ACCELERATED_COMPOSITING)
@@ -69,6 +69,14 @@ public:
 
     void beginAnimationUpdate();
     void endAnimationUpdate();
+
+/* FYWEBKITMOD BEGIN */
+    // Frame clock driven animation (see Settings::animationFrameClockEnabled()). The
+    // embedder calls serviceAnimations() once per display frame with the frame time
+    // (in currentTime() units) for as long as needsAnimationFrame() is true.
+    bool needsAnimationFrame() const;
+    void serviceAnimations(double frameTime);
+/* FYWEBKITMOD END */
     
     static bool supportsAcceleratedAnimationOfProperty(CSSPropertyID);
 
@@ -81,6 +81,12 @@ public:
 
     double beginAnimationUpdateTime();
     void setBeginAnimationUpdateTime(double t) { m_beginAnimationUpdateTime = t; }
+/* FYWEBKITMOD BEGIN */
+    void beginAnimationUpdate();
+    bool usesFrameClock() const;
+    bool needsFrameService() const { return m_needsFrameService; }
+    void serviceAnimations(double frameTime);
+/* FYWEBKITMOD END */
     void endAnimationUpdate();
     void receivedStartTimeResponse(double);
     
@@ -120,6 +126,11 @@ private:
     AnimationBase* m_responseWaiters;
     AnimationBase* m_lastResponseWaiter;
     bool m_waitingForResponse;
+
+/* FYWEBKITMOD BEGIN */
+    bool m_needsFrameService;
+    double m_frameClockTime;
+/* FYWEBKITMOD END */
 };
 
 } // namespace WebCore
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#include "config.h"
+#include "SpatialNavigationIndexFymp.h"
+
+#include "Document.h"
+#include "FrameView.h"
+#include "Node.h"
+#include "RenderObject.h"
+#include "RenderStyle.h"
+#include "SpatialNavigation.h"
+
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// A tile of a program guide or a poster wall.
+static const int initialCellSize = 128;
+
+// Keeps the grid of a long document with few focusable elements small.
+static const size_t minimumCellLimit = 4096;
+
+struct SpatialNavigationIndexFymp::Query {
+    Node* focusedNode;
+    IntRect focusedRect; // Relative to the root document, like the candidates' rects
+    IntSize scrollOffset;
+    FocusDirection direction;
+    KeyboardEvent* event;
+    bool horizontal;
+    FocusCandidate* closest;
+    unsigned closestIndex;
+};
+
+static SpatialNavigationIndexStatistics& mutableStatistics()
+{
+    DEFINE_STATIC_LOCAL(SpatialNavigationIndexStatistics, statistics, ());
+    return statistics;
+}
+
+const SpatialNavigationIndexStatistics& SpatialNavigationIndexFymp::statistics()
+{
+    return mutableStatistics();
+}
+
+// Fixed positioned and transformed boxes move without a layout, when the view
+// scrolls or a transition runs.
+static bool canMoveWithoutLayout(RenderObject* renderer)
+{
+    for (; renderer; renderer = renderer->parent()) {
+        if (renderer->hasTransform() || renderer->style()->position() == FixedPosition)
+            return true;
+    }
+    return false;
+}
+
+// A None aligned candidate is at least |gap| away on the cross axis.
+static bool canBeCloser(long long gap, const FocusCandidate& closest)
+{
+    return closest.isNull() || gap <= 0 || gap * gap <= closest.distance;
+}
+
+SpatialNavigationIndexFymp::SpatialNavigationIndexFymp(Document* document)
+    : m_document(document)
+    , m_built(false)
+    , m_supported(false)
+    , m_focusableElementsVersion(0)
+    , m_layoutCount(0)
+    , m_layerScrollCount(0)
+    , m_cellSize(initialCellSize)
+    , m_originColumn(0)
+    , m_originRow(0)
+    , m_columns(0)
+    , m_rows(0)
+    , m_queryNumber(0)
+{
+}
+
+bool SpatialNavigationIndexFymp::findCandidate(Node* focusedNode, FocusDirection direction, KeyboardEvent* event, FocusCandidate& closest)
+{
+    if (!m_document->view() || focusedNode->document() != m_document) {
+        ++mutableStatistics().fallbacks;
+        return false;
+    }
+
+    if (!isCurrent())
+        rebuild();
+    if (!m_supported) {
+        ++mutableStatistics().fallbacks;
+        return false;
+    }
+    ++mutableStatistics().queries;
+
+    // distanceDataForNode() gives every candidate the maximum distance then.
+    IntRect focusedRect = focusedNode->renderer() ? focusedNode->getRect() : IntRect();
+    if (focusedRect.isEmpty())
+        return true;
+
+    if (!++m_queryNumber) {
+        m_checked.fill(0);
+        m_queryNumber = 1;
+    }
+
+    Query query;
+    query.focusedNode = focusedNode;
+    query.scrollOffset = m_document->view()->scrollOffset();
+    query.focusedRect = focusedRect;
+    query.focusedRect.move(-query.scrollOffset);
+    query.direction = direction;
+    query.event = event;
+    query.horizontal = direction == FocusDirectionLeft || direction == FocusDirectionRight;
+    query.closest = &closest;
+    query.closestIndex = 0;
+
+    for (size_t i = 0; i < m_movableEntries.size(); ++i) {
+        unsigned index = m_movableEntries[i];
+        checkCandidate(query, index, m_entries[index].node->getRect());
+    }
+
+    if (m_cells.isEmpty())
+        return true;
+
+    // Candidates have their center beyond the focused element's edge, which
+    // deflateIfOverlapped() may move in by fudgeFactor().
+    int mainCount = query.horizontal ? m_columns : m_rows;
+    int mainOrigin = query.horizontal ? m_originColumn : m_originRow;
+    int firstMain = 0;
+    int lastMain = mainCount - 1;
+    switch (direction) {
+    case FocusDirectionLeft:
+        lastMain = cellIndex(focusedRect.x() + fudgeFactor()) - mainOrigin;
+        break;
+    case FocusDirectionRight:
+        firstMain = cellIndex(focusedRect.right() - fudgeFactor()) - mainOrigin;
+        break;
+    case FocusDirectionUp:
+        lastMain = cellIndex(focusedRect.y() + fudgeFactor()) - mainOrigin;
+        break;
+    case FocusDirectionDown:
+        firstMain = cellIndex(focusedRect.bottom() - fudgeFactor()) - mainOrigin;
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+    firstMain = max(firstMain, 0);
+    lastMain = min(lastMain, mainCount - 1);
+    if (firstMain > lastMain)
+        return true;
+
+    // Fully or partially aligned candidates overlap the focused element on the
+    // cross axis, so they are all in the band of cells it spans.
+    int crossCount = query.horizontal ? m_rows : m_columns;
+    int crossOrigin = query.horizontal ? m_originRow : m_originColumn;
+    int crossStart = query.horizontal ? focusedRect.y() : focusedRect.x();
+    int crossEnd = query.horizontal ? focusedRect.bottom() : focusedRect.right();
+    int firstBand = cellIndex(crossStart) - crossOrigin;
+    int lastBand = cellIndex(crossEnd) - crossOrigin;
+    for (int cross = max(firstBand, 0); cross <= min(lastBand, crossCount - 1); ++cross)
+        checkCells(query, cross, firstMain, lastMain);
+
+    // No aligned candidate in the band, so widen it as long as a candidate
+    // first met in the next row or column could still be closer.
+    if (!closest.isNull() && closest.alignment != None)
+        return true;
+
+    bool searchBefore = true;
+    bool searchAfter = true;
+    for (int step = 1; searchBefore || searchAfter; ++step) {
+        int before = firstBand - step;
+        if (searchBefore) {
+            if (before < 0)
+                searchBefore = false;
+            else if (before < crossCount) {
+                long long gap = crossStart - static_cast<long long>(before + crossOrigin + 1) * m_cellSize;
+                if (canBeCloser(gap, closest))
+                    checkCells(query, before, firstMain, lastMain);
+                else
+                    searchBefore = false;
+            }
+        }
+
+        int after = lastBand + step;
+        if (searchAfter) {
+            if (after >= crossCount)
+                searchAfter = false;
+            else if (after >= 0) {
+                long long gap = static_cast<long long>(after + crossOrigin) * m_cellSize - crossEnd;
+                if (canBeCloser(gap, closest))
+                    checkCells(query, after, firstMain, lastMain);
+                else
+                    searchAfter = false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SpatialNavigationIndexFymp::isCurrent() const
+{
+    return m_built
+        && m_focusableElementsVersion == m_document->focusableElementsVersion()
+        && m_layoutCount == m_document->view()->layoutCount()
+        && m_layerScrollCount == m_document->layerScrollCount();
+}
+
+void SpatialNavigationIndexFymp::rebuild()
+{
+    ++mutableStatistics().rebuilds;
+
+    m_built = true;
+    m_supported = true;
+    m_focusableElementsVersion = m_document->focusableElementsVersion();
+    m_layoutCount = m_document->view()->layoutCount();
+    m_layerScrollCount = m_document->layerScrollCount();
+    m_entries.clear();
+    m_movableEntries.clear();
+    m_cells.clear();
+    m_checked.clear();
+    m_queryNumber = 0;
+
+    for (Node* node = m_document->firstChild(); node; node = node->traverseNextNode()) {
+        if (node->isFrameOwnerElement() || isScrollableContainerNode(node)) {
+            m_supported = false;
+            m_entries.clear();
+            m_movableEntries.clear();
+            return;
+        }
+
+        RenderObject* renderer = node->renderer();
+        if (!renderer || !node->supportsFocus())
+            continue;
+
+        Entry entry;
+        entry.node = node;
+        if (canMoveWithoutLayout(renderer))
+            m_movableEntries.append(m_entries.size());
+        else {
+            // Empty rects are never candidates.
+            entry.rect = node->getRect();
+            if (entry.rect.isEmpty())
+                continue;
+        }
+        m_entries.append(entry);
+    }
+
+    m_checked.fill(0, m_entries.size());
+    buildGrid();
+}
+
+void SpatialNavigationIndexFymp::buildGrid()
+{
+    m_cellSize = initialCellSize;
+    m_columns = 0;
+    m_rows = 0;
+
+    IntRect bounds;
+    for (size_t i = 0; i < m_entries.size(); ++i)
+        bounds.unite(m_entries[i].rect);
+    if (bounds.isEmpty())
+        return;
+
+    size_t cellLimit = max(minimumCellLimit, 4 * m_entries.size());
+    while (true) {
+        m_originColumn = cellIndex(bounds.x());
+        m_originRow = cellIndex(bounds.y());
+        m_columns = cellIndex(bounds.right()) - m_originColumn + 1;
+        m_rows = cellIndex(bounds.bottom()) - m_originRow + 1;
+        if (static_cast<size_t>(m_columns) * m_rows <= cellLimit)
+            break;
+        m_cellSize *= 2;
+    }
+
+    // Both edges count, as the alignment rules compare right() and bottom()
+    // inclusively.
+    m_cells.resize(m_columns * m_rows);
+    for (unsigned i = 0; i < m_entries.size(); ++i) {
+        const IntRect& rect = m_entries[i].rect;
+        if (rect.isEmpty())
+            continue;
+        int firstColumn = cellIndex(rect.x()) - m_originColumn;
+        int lastColumn = cellIndex(rect.right()) - m_originColumn;
+        int lastRow = cellIndex(rect.bottom()) - m_originRow;
+        for (int row = cellIndex(rect.y()) - m_originRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column)
+                m_cells[row * m_columns + column].append(i);
+        }
+    }
+}
+
+int SpatialNavigationIndexFymp::cellIndex(int coordinate) const
+{
+    if (coordinate >= 0)
+        return coordinate / m_cellSize;
+    return -((m_cellSize - 1 - coordinate) / m_cellSize);
+}
+
+void SpatialNavigationIndexFymp::checkCells(Query& query, int cross, int firstMain, int lastMain)
+{
+    for (int main = firstMain; main <= lastMain; ++main) {
+        const Vector<unsigned>& cell = query.horizontal ? m_cells[cross * m_columns + main] : m_cells[main * m_columns + cross];
+        for (size_t i = 0; i < cell.size(); ++i)
+            checkCandidate(query, cell[i], m_entries[cell[i]].rect);
+    }
+}
+
+void SpatialNavigationIndexFymp::checkCandidate(Query& query, unsigned index, const IntRect& absoluteRect)
+{
+    if (m_checked[index] == m_queryNumber)
+        return;
+    m_checked[index] = m_queryNumber;
+
+    Node* node = m_entries[index].node;
+    if (node == query.focusedNode || !node->isKeyboardFocusable(query.event))
+        return;
+
+    ++mutableStatistics().candidatesChecked;
+
+    FocusCandidate candidate(node);
+    IntRect rect = absoluteRect;
+    rect.move(-query.scrollOffset);
+    distanceDataForRects(query.direction, query.focusedNode, query.focusedRect, rect, candidate);
+    if (candidate.distance == maxDistance())
+        return;
+
+    // As updateFocusCandidateInSameContainer(), which keeps the element that
+    // comes first in document order on a tie.
+    FocusCandidate& closest = *query.closest;
+    if (!closest.isNull()) {
+        if (candidate.alignment < closest.alignment)
+            return;
+        if (candidate.alignment == closest.alignment
+            && (candidate.distance > closest.distance || (candidate.distance == closest.distance && index > query.closestIndex)))
+            return;
+    }
+    closest = candidate;
+    query.closestIndex = index;
+}
+
+} // namespace WebCore
+
+/* FYWEBKITMOD END */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef SpatialNavigationIndexFymp_h
+#define SpatialNavigationIndexFymp_h
+
+#include "FocusDirection.h"
+#include "IntRect.h"
+
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Document;
+class KeyboardEvent;
+class Node;
+struct FocusCandidate;
+
+struct SpatialNavigationIndexStatistics {
+    unsigned queries; // Directional moves answered from an index
+    unsigned rebuilds; // Indices built again after focusable elements, layout or a layer scroll changed
+    unsigned fallbacks; // Moves left to FocusController's walk over all nodes
+    unsigned candidatesChecked; // Elements whose distance had to be computed
+};
+
+// Focusable elements of a document by position, for spatial navigation.
+//
+// FocusController::findFocusableNodeInDirection() visits every node of every
+// frame and computes the distance to each focusable one on every arrow key.
+// The index keeps the elements that support focus together with their
+// absolute rects in a grid of square cells. A move first looks at the cells
+// in line with the focused element, where all aligned candidates are, and
+// then widens the search only as far as a candidate could still be closer.
+// Candidates are compared with the same rules, so the result is the same
+// element the walk finds.
+//
+// The index is dropped whenever nodes are inserted or removed, an attribute
+// that decides focusability changes (see
+// Document::didChangeFocusableElements()), the document's view lays out or a
+// layer scrolls, and built again on the next move. Other attribute changes,
+// e.g. toggling a focus class that only changes colors, and view scrolling
+// don't invalidate it. Elements that are
+// fixed positioned or transformed can move without a layout; they are kept
+// aside and measured on every move. Documents with frames or scrollable
+// boxes rank candidates by their container first and are left to the walk.
+class SpatialNavigationIndexFymp : public Noncopyable {
+public:
+    explicit SpatialNavigationIndexFymp(Document*);
+
+    // Finds the element to move the focus to from |focusedNode| like
+    // FocusController::findFocusableNodeInDirection() does for the whole
+    // document. Returns false if the document isn't one the index handles.
+    bool findCandidate(Node* focusedNode, FocusDirection, KeyboardEvent*, FocusCandidate& closest);
+
+    static const SpatialNavigationIndexStatistics& statistics();
+
+private:
+    struct Entry {
+        Node* node;
+        IntRect rect; // Absolute, i.e. not moved by the view's scroll offset
+    };
+
+    struct Query;
+
+    bool isCurrent() const;
+    void rebuild();
+    void buildGrid();
+    int cellIndex(int coordinate) const;
+    void checkCells(Query&, int cross, int firstMain, int lastMain);
+    void checkCandidate(Query&, unsigned index, const IntRect&);
+
+    Document* m_document;
+
+    bool m_built;
+    bool m_supported;
+    unsigned m_focusableElementsVersion;
+    int m_layoutCount;
+    unsigned m_layerScrollCount;
+
+    Vector<Entry> m_entries; // In document order
+    Vector<unsigned> m_movableEntries; // Fixed positioned or transformed, measured on every move
+
+    int m_cellSize;
+    int m_originColumn;
+    int m_originRow;
+    int m_columns;
+    int m_rows;
+    Vector<Vector<unsigned> > m_cells; // Entry indices, row by row
+
+    Vector<unsigned> m_checked; // Query number each entry was last checked in
+    unsigned m_queryNumber;
+};
+
+} // namespace WebCore
+
+#endif // SpatialNavigationIndexFymp_h
+
+/* FYWEBKITMOD END */
@@ -40,6 +40,7 @@
 #include "RenderProgress.h"
 #include "RenderSlider.h"
 #include "ScrollbarTheme.h"
+#include "ThemePartCacheFymp.h" // FYWEBKITMOD
 #include "TimeRanges.h"
 #include "TransformationMatrix.h"
 #include "UserAgentStyleSheets.h"
@@ -174,6 +175,19 @@ RenderThemeFymp::~RenderThemeFymp()
 {
 }
 
+/* FYWEBKITMOD BEGIN */
+void RenderThemeFymp::themeChanged()
+{
+    ThemePartCacheFymp::shared().clear();
+}
+
+void RenderThemeFymp::platformColorsDidChange()
+{
+    ThemePartCacheFymp::shared().clear();
+    RenderTheme::platformColorsDidChange();
+}
+/* FYWEBKITMOD END */
+
 String RenderThemeFymp::extraDefaultStyleSheet()
 {
     return String(); // FYWEBKITMOD removed implementation
@@ -355,16 +369,26 @@ static SkColor brightenColor(double h, double s, double l, float brightenAmount)
     return makeRGBAFromHSLA(h, s, l, 1.0);
 }
 
-static void paintButtonLike(RenderTheme* theme, RenderObject* o, const PaintInfo& i, const IntRect& rect)
+/* FYWEBKITMOD BEGIN split into paintButtonLike() and paintButtonLikeAppearance() for ThemePartCacheFymp */
+// Everything a button-like appearance depends on besides its size.
+struct ButtonLikeAppearance {
+    SkColor baseColor;
+    bool hovered;
+    bool pressed;
+};
+
+// Width of the cached template, enough for both edges and the corner dots
+// around a uniform center column.
+static const int buttonLikeTemplateWidth = 5;
+
+static void paintButtonLikeAppearance(SkCanvas* canvas, const IntRect& rect, const void* context)
 {
-    SkCanvas* const canvas = i.context->platformContext()->canvas();
+    const ButtonLikeAppearance& appearance = *static_cast<const ButtonLikeAppearance*>(context);
     SkPaint paint;
     SkRect skrect;
     const int right = rect.x() + rect.width();
     const int bottom = rect.y() + rect.height();
-    SkColor baseColor = SkColorSetARGB(0xff, 0xdd, 0xdd, 0xdd);
-    if (o->hasBackground())
-        baseColor = o->style()->visitedDependentColor(CSSPropertyBackgroundColor).rgb();
+    SkColor baseColor = appearance.baseColor;
     double h, s, l;
     Color(baseColor).getHSL(h, s, l);
     // Our standard gradient is from 0xdd to 0xf8. This is the amount of
@@ -379,7 +403,7 @@ static void paintButtonLike(RenderTheme* theme, RenderObject* o, const PaintInfo
         return;
     }
 
-    const int borderAlpha = theme->isHovered(o) ? 0x80 : 0x55;
+    const int borderAlpha = appearance.hovered ? 0x80 : 0x55;
     paint.setARGB(borderAlpha, 0, 0, 0);
     canvas->drawLine(rect.x() + 1, rect.y(), right - 1, rect.y(), paint);
     canvas->drawLine(right - 1, rect.y() + 1, right - 1, bottom - 1, paint);
@@ -388,7 +412,7 @@ static void paintButtonLike(RenderTheme* theme, RenderObject* o, const PaintInfo
 
     paint.setColor(SK_ColorBLACK);
     SkPoint p[2];
-    const int lightEnd = theme->isPressed(o) ? 1 : 0;
+    const int lightEnd = appearance.pressed ? 1 : 0;
     const int darkEnd = !lightEnd;
     p[lightEnd].set(SkIntToScalar(rect.x()), SkIntToScalar(rect.y()));
     p[darkEnd].set(SkIntToScalar(rect.x()), SkIntToScalar(bottom - 1));
@@ -413,6 +437,33 @@ static void paintButtonLike(RenderTheme* theme, RenderObject* o, const PaintInfo
     canvas->drawPoint(right - 2, bottom - 2, paint);
 }
 
+static void paintButtonLike(RenderTheme* theme, RenderObject* o, const PaintInfo& i, const IntRect& rect)
+{
+    SkCanvas* const canvas = i.context->platformContext()->canvas();
+
+    ButtonLikeAppearance appearance;
+    appearance.baseColor = SkColorSetARGB(0xff, 0xdd, 0xdd, 0xdd);
+    if (o->hasBackground())
+        appearance.baseColor = o->style()->visitedDependentColor(CSSPropertyBackgroundColor).rgb();
+    appearance.hovered = theme->isHovered(o);
+    appearance.pressed = theme->isPressed(o);
+
+    // Buttons too small for the template are a single solid rect.
+    if (rect.width() >= buttonLikeTemplateWidth && rect.height() >= buttonLikeTemplateWidth) {
+        ThemePartCacheFymp::Key key;
+        key.part = PushButtonPart;
+        key.state = appearance.hovered | appearance.pressed << 1;
+        key.color = appearance.baseColor;
+        key.width = 0;
+        key.height = rect.height();
+        if (ThemePartCacheFymp::shared().draw(canvas, rect, key, buttonLikeTemplateWidth, paintButtonLikeAppearance, &appearance))
+            return;
+    }
+
+    paintButtonLikeAppearance(canvas, rect, &appearance);
+}
+/* FYWEBKITMOD END */
+
 bool RenderThemeFymp::paintButton(RenderObject* o, const PaintInfo& i, const IntRect& rect)
 {
     paintButtonLike(this, o, i, rect);
@@ -851,14 +902,19 @@ bool RenderThemeFymp::paintSliderTrack(RenderObject*, const PaintInfo& i, const
     return false;
 }
 
-bool RenderThemeFymp::paintSliderThumb(RenderObject* o, const PaintInfo& i, const IntRect& rect)
+/* FYWEBKITMOD BEGIN split into paintSliderThumb() and paintSliderThumbAppearance() for ThemePartCacheFymp */
+struct SliderThumbAppearance {
+    bool hovered;
+    bool vertical;
+};
+
+static void paintSliderThumbAppearance(SkCanvas* canvas, const IntRect& rect, const void* context)
 {
-    // Make a thumb similar to the scrollbar thumb.
-    const bool hovered = isHovered(o) || toRenderSlider(o->parent())->inDragMode();
+    const SliderThumbAppearance& appearance = *static_cast<const SliderThumbAppearance*>(context);
+    const bool hovered = appearance.hovered;
+    const bool vertical = appearance.vertical;
     const int midx = rect.x() + rect.width() / 2;
     const int midy = rect.y() + rect.height() / 2;
-    const bool vertical = (o->style()->appearance() == SliderThumbVerticalPart);
-    SkCanvas* const canvas = i.context->platformContext()->canvas();
 
     const SkColor thumbLightGrey = SkColorSetARGB(0xff, 0xf4, 0xf2, 0xef);
     const SkColor thumbDarkGrey = SkColorSetARGB(0xff, 0xea, 0xe5, 0xe0);
@@ -891,9 +947,28 @@ bool RenderThemeFymp::paintSliderThumb(RenderObject* o, const PaintInfo& i, cons
         drawHorizLine(canvas, midx - 2, midx + 2, midy - 3, paint);
         drawHorizLine(canvas, midx - 2, midx + 2, midy + 3, paint);
     }
+}
+
+bool RenderThemeFymp::paintSliderThumb(RenderObject* o, const PaintInfo& i, const IntRect& rect)
+{
+    // Make a thumb similar to the scrollbar thumb.
+    SliderThumbAppearance appearance;
+    appearance.hovered = isHovered(o) || toRenderSlider(o->parent())->inDragMode();
+    appearance.vertical = (o->style()->appearance() == SliderThumbVerticalPart);
+    SkCanvas* const canvas = i.context->platformContext()->canvas();
+
+    ThemePartCacheFymp::Key key;
+    key.part = appearance.vertical ? SliderThumbVerticalPart : SliderThumbHorizontalPart;
+    key.state = appearance.hovered;
+    key.color = 0;
+    key.width = rect.width();
+    key.height = rect.height();
+    if (!ThemePartCacheFymp::shared().draw(canvas, rect, key, 0, paintSliderThumbAppearance, &appearance))
+        paintSliderThumbAppearance(canvas, rect, &appearance);
 
     return false;
 }
+/* FYWEBKITMOD END */
 
 int RenderThemeFymp::popupInternalPaddingLeft(RenderStyle* style) const
 {
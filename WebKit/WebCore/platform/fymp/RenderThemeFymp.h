@@ -45,6 +45,12 @@ class RenderProgress;
 
         static PassRefPtr<RenderTheme> create(); // FYWEBKITMOD
 
+/* FYWEBKITMOD BEGIN */
+        // Both drop the cached control appearances.
+        virtual void themeChanged();
+        virtual void platformColorsDidChange();
+/* FYWEBKITMOD END */
+
         virtual String extraDefaultStyleSheet();
         virtual String extraQuirksStyleSheet();
 #if ENABLE(VIDEO)
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#include "config.h"
+#include "ThemePartCacheFymp.h"
+
+#include "IntRect.h"
+
+#include "SkCanvas.h"
+#include "SkPaint.h"
+
+#include <wtf/HashFunctions.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// A settings screen full of buttons and sliders in a few sizes.
+static const size_t defaultBudget = 512 * 1024;
+
+// Larger parts are rare and cheap to paint compared to their footprint.
+static const int maximumPartArea = 256 * 64;
+
+ThemePartCacheFymp& ThemePartCacheFymp::shared()
+{
+    DEFINE_STATIC_LOCAL(ThemePartCacheFymp, cache, ());
+    return cache;
+}
+
+ThemePartCacheFymp::ThemePartCacheFymp()
+    : m_entries(defaultBudget)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+bool ThemePartCacheFymp::Key::operator==(const Key& other) const
+{
+    return part == other.part && state == other.state && color == other.color && width == other.width && height == other.height;
+}
+
+unsigned ThemePartCacheFymp::Key::hash() const
+{
+    unsigned hash = WTF::intHash(static_cast<uint64_t>(part) << 32 | state);
+    hash = WTF::intHash(static_cast<uint64_t>(hash) << 32 | static_cast<uint32_t>(color));
+    return WTF::intHash(static_cast<uint64_t>(hash) << 32 | static_cast<uint32_t>(width << 16 | height));
+}
+
+bool ThemePartCacheFymp::draw(SkCanvas* canvas, const IntRect& rect, const Key& key, int templateWidth, PaintFunction paint, const void* context)
+{
+    if (!m_entries.budget() || rect.isEmpty() || rect.height() != key.height)
+        return false;
+
+    bool stretched = !key.width;
+    if (stretched ? rect.width() < templateWidth : rect.width() != key.width)
+        return false;
+
+    int bitmapWidth = stretched ? templateWidth : key.width;
+    if (bitmapWidth * key.height > maximumPartArea)
+        return false;
+
+    // Only whole pixel translations give the same pixels as painting directly.
+    const SkMatrix& matrix = canvas->getTotalMatrix();
+    if (matrix.getType() & ~SkMatrix::kTranslate_Mask)
+        return false;
+    if (SkScalarFraction(matrix.getTranslateX()) || SkScalarFraction(matrix.getTranslateY()))
+        return false;
+
+    Entry* entry = m_entries.find(key);
+    if (entry)
+        ++m_hits;
+    else {
+        ++m_misses;
+        entry = createEntry(key, bitmapWidth, paint, context);
+        if (!entry)
+            return false;
+    }
+
+    SkPaint bitmapPaint;
+    bitmapPaint.setFilterBitmap(false);
+    if (!stretched || rect.width() == templateWidth) {
+        canvas->drawBitmap(entry->bitmap, SkIntToScalar(rect.x()), SkIntToScalar(rect.y()), &bitmapPaint);
+        return true;
+    }
+
+    // Left edge, stretched center column, right edge.
+    int center = templateWidth / 2;
+    int sourceX[4] = { 0, center, center + 1, templateWidth };
+    int destX[4] = { rect.x(), rect.x() + center, rect.right() - (templateWidth - center - 1), rect.right() };
+    for (unsigned column = 0; column < 3; ++column) {
+        SkIRect source;
+        source.set(sourceX[column], 0, sourceX[column + 1], key.height);
+        SkRect dest;
+        dest.set(SkIntToScalar(destX[column]), SkIntToScalar(rect.y()), SkIntToScalar(destX[column + 1]), SkIntToScalar(rect.bottom()));
+        canvas->drawBitmapRect(entry->bitmap, &source, dest, &bitmapPaint);
+    }
+    return true;
+}
+
+ThemePartCacheFymp::Entry* ThemePartCacheFymp::createEntry(const Key& key, int width, PaintFunction paint, const void* context)
+{
+    Entry* entry = new Entry;
+    entry->key = key;
+
+    SkBitmap& bitmap = entry->bitmap;
+    bitmap.setConfig(SkBitmap::kARGB_8888_Config, width, key.height);
+    if (!bitmap.allocPixels()) {
+        delete entry;
+        return 0;
+    }
+    bitmap.eraseARGB(0, 0, 0, 0);
+
+    SkCanvas canvas(bitmap);
+    paint(&canvas, IntRect(0, 0, width, key.height), context);
+
+    entry->cost = bitmap.getSize();
+    m_entries.add(entry);
+
+    return entry;
+}
+
+} // namespace WebCore
+
+/* FYWEBKITMOD END */
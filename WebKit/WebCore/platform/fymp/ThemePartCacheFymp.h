@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef ThemePartCacheFymp_h
+#define ThemePartCacheFymp_h
+
+#include "BudgetedLRUCacheFymp.h"
+
+#include "SkBitmap.h"
+#include "SkColor.h"
+
+#include <wtf/Noncopyable.h>
+
+class SkCanvas;
+
+namespace WebCore {
+
+class IntRect;
+
+// Cache of rendered form control parts for RenderThemeFymp.
+//
+// Control appearances only depend on the part, its state, its base color and
+// its size, so each combination is painted once into a bitmap and blitted on
+// later paints. Parts that are uniform between their left and right edges are
+// cached as a narrow template whose center column is stretched to any width.
+//
+// Entries are evicted in least recently used order once their total size
+// exceeds budget(). The theme clears the cache whenever its look changes.
+class ThemePartCacheFymp : public Noncopyable {
+public:
+    static ThemePartCacheFymp& shared();
+
+    struct Key {
+        unsigned hash() const;
+        bool operator==(const Key&) const;
+        // Parts always have a height, so a zero height marks the empty bucket
+        // and a negative one the deleted bucket.
+        bool isHashTableDeletedValue() const { return height == -1; }
+        void setHashTableDeletedValue() { height = -1; }
+
+        unsigned part; // ControlPart
+        unsigned state; // Theme specific state bits
+        SkColor color;
+        int width; // 0 for templates stretched horizontally
+        int height;
+    };
+
+    // Paints the part described by |key| into |rect| from the cache. Calls
+    // |paint| to render the bitmap on a miss, with the part rect at (0, 0).
+    // Templates are rendered |templateWidth| pixels wide and must have a
+    // uniform center column. Returns false without drawing if the canvas
+    // transform doesn't allow a pixel exact copy; the caller then paints
+    // directly.
+    typedef void (*PaintFunction)(SkCanvas*, const IntRect&, const void* context);
+    bool draw(SkCanvas*, const IntRect&, const Key&, int templateWidth, PaintFunction, const void* context);
+
+    void setBudget(size_t bytes) { m_entries.setBudget(bytes); }
+    size_t budget() const { return m_entries.budget(); }
+    size_t size() const { return m_entries.size(); }
+
+    void clear() { m_entries.clear(); }
+
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    ThemePartCacheFymp();
+
+    struct Entry {
+        Key key;
+        size_t cost;
+        SkBitmap bitmap;
+    };
+
+    Entry* createEntry(const Key&, int width, PaintFunction, const void* context);
+
+    BudgetedLRUCacheFymp<Key, Entry> m_entries;
+
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+} // namespace WebCore
+
+#endif // ThemePartCacheFymp_h
+
+/* FYWEBKITMOD END */
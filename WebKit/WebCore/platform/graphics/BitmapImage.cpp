@@ -255,6 +255,16 @@ bool BitmapImage::frameHasAlphaAtIndex(size_t index)
     return m_frames[index].m_hasAlpha;
 }
 
+/* FYWEBKITMOD BEGIN */
+bool BitmapImage::currentFrameKnownToBeOpaque()
+{
+    // The decoder reports alpha per frame; a frame that is still loading is
+    // transparent where data is missing.
+    size_t index = currentFrame();
+    return frameIsCompleteAtIndex(index) && !frameHasAlphaAtIndex(index);
+}
+/* FYWEBKITMOD END */
+
 /* FYWEBKITMOD BEGIN changed implementation of nativeImageForCurrentFrame() and added two other functions */
 NativeImagePtr BitmapImage::nativeImageForCurrentFrame()
 {
@@ -159,6 +159,10 @@ public:
     virtual NativeImagePtr nativeImageForCurrentFrame();
 /* FYWEBKITMOD END */
 
+/* FYWEBKITMOD BEGIN */
+    virtual bool currentFrameKnownToBeOpaque();
+/* FYWEBKITMOD END */
+
 /* FYWEBKITMOD BEGIN */
     double getNativeImageAge();  // time (in sec) since the first time BitmapImage successfully made a NativeImagePtr
 /* FYWEBKITMOD END */
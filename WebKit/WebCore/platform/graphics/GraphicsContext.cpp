@@ -448,6 +448,15 @@ void GraphicsContext::addRoundedRectClip(const IntRect& rect, const IntSize& top
     if (paintingDisabled())
         return;
 
+    /* FYWEBKITMOD BEGIN */
+    // Without any radius the path is a plain rect, which the platform can
+    // recognize and clip to without antialiasing when it is pixel aligned.
+    if (topLeft.isZero() && topRight.isZero() && bottomLeft.isZero() && bottomRight.isZero()) {
+        clip(Path::createRectangle(rect));
+        return;
+    }
+    /* FYWEBKITMOD END */
+
     clip(Path::createRoundedRectangle(rect, topLeft, topRight, bottomLeft, bottomRight));
 }
 
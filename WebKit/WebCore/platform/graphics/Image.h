@@ -92,6 +92,12 @@ public:
 
     virtual bool isBitmapImage() const { return false; }
 
+/* FYWEBKITMOD BEGIN */
+    // True only if drawing the current frame is known to cover every pixel of
+    // its destination.
+    virtual bool currentFrameKnownToBeOpaque() { return false; }
+/* FYWEBKITMOD END */
+
     // Derived classes should override this if they can assure that 
     // the image contains only resources from its own security origin.
     virtual bool hasSingleSecurityOrigin() const { return false; }
@@ -29,6 +29,9 @@
 #include "Filter.h"
 #include "GraphicsContext.h"
 #include "ImageData.h"
+#if PLATFORM(FYMP) // FYWEBKITMOD
+#include "BoxBlurSkia.h"
+#endif
 #include <math.h>
 #include <wtf/MathExtras.h>
 
@@ -123,14 +126,18 @@ void FEGaussianBlur::apply(Filter* filter)
     CanvasPixelArray* srcPixelArray(srcImageData->data());
 
     IntRect imageRect(IntPoint(), resultImage()->size());
+    int stride = 4 * imageRect.width();
+#if PLATFORM(FYMP) // FYWEBKITMOD: packed three pass box blur
+    boxBlurPremultiplied(srcPixelArray->data()->data(), imageRect.width(), imageRect.height(), stride, sdx, sdy);
+#else
     RefPtr<ImageData> tmpImageData = ImageData::create(imageRect.width(), imageRect.height());
     CanvasPixelArray* tmpPixelArray(tmpImageData->data());
 
-    int stride = 4 * imageRect.width();
     for (int i = 0; i < 3; ++i) {
         boxBlur(srcPixelArray, tmpPixelArray, sdx, 4, stride, imageRect.width(), imageRect.height(), isAlphaImage());
         boxBlur(tmpPixelArray, srcPixelArray, sdy, stride, 4, imageRect.height(), imageRect.width(), isAlphaImage());
     }
+#endif
 
     resultImage()->putPremultipliedImageData(srcImageData.get(), imageRect, IntPoint());
 }
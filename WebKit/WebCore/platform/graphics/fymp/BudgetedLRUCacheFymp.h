@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef BudgetedLRUCacheFymp_h
+#define BudgetedLRUCacheFymp_h
+
+#include <wtf/HashMap.h>
+#include <wtf/HashTraits.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+// Entries of a painting cache, evicted in least recently used order once
+// their total cost exceeds a byte budget.
+//
+// The cache owns its entries. |Entry| has a |key| member of type |Key| and a
+// |cost| member in bytes. |Key| is a plain struct with hash(), operator==()
+// and a deleted marker (isHashTableDeletedValue() and
+// setHashTableDeletedValue()); an all zero key marks the empty bucket and
+// must never be a real key.
+template<typename Key, typename Entry>
+class BudgetedLRUCacheFymp : public Noncopyable {
+public:
+    explicit BudgetedLRUCacheFymp(size_t budget)
+        : m_budget(budget)
+        , m_size(0)
+    {
+    }
+
+    ~BudgetedLRUCacheFymp() { clear(); }
+
+    // Returns the entry for |key| and marks it as the most recently used, or
+    // 0 if there is none.
+    Entry* find(const Key& key)
+    {
+        Entry* entry = m_entries.get(key);
+        if (entry) {
+            m_recentlyUsed.remove(entry);
+            m_recentlyUsed.add(entry);
+        }
+        return entry;
+    }
+
+    // Adds |entry| as the most recently used one. Older entries are dropped
+    // until the cache fits its budget again; |entry| itself is kept even if it
+    // exceeds the budget on its own.
+    void add(Entry* entry)
+    {
+        ASSERT(!m_entries.contains(entry->key));
+        m_entries.set(entry->key, entry);
+        m_recentlyUsed.add(entry);
+        m_size += entry->cost;
+        evictToBudget(entry);
+    }
+
+    // Accounts for |bytes| more of |entry|, e.g. data filled in on a later hit.
+    void addCost(Entry* entry, size_t bytes)
+    {
+        entry->cost += bytes;
+        m_size += bytes;
+        evictToBudget(entry);
+    }
+
+    void remove(Entry* entry)
+    {
+        m_recentlyUsed.remove(entry);
+        m_entries.remove(entry->key);
+        m_size -= entry->cost;
+        delete entry;
+    }
+
+    void setBudget(size_t bytes)
+    {
+        m_budget = bytes;
+        evictToBudget(0);
+    }
+
+    size_t budget() const { return m_budget; }
+    size_t size() const { return m_size; }
+
+    void clear()
+    {
+        deleteAllValues(m_entries);
+        m_entries.clear();
+        m_recentlyUsed.clear();
+        m_size = 0;
+    }
+
+private:
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return key.hash(); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+
+    struct KeyTraits : WTF::GenericHashTraits<Key> {
+        static const bool emptyValueIsZero = true;
+        static const bool needsDestruction = false;
+        static void constructDeletedValue(Key& key) { key.setHashTableDeletedValue(); }
+        static bool isDeletedValue(const Key& key) { return key.isHashTableDeletedValue(); }
+    };
+
+    // Drops least recently used entries other than |keep| until we fit the budget.
+    void evictToBudget(Entry* keep)
+    {
+        while (m_size > m_budget && !m_recentlyUsed.isEmpty()) {
+            Entry* entry = *m_recentlyUsed.begin();
+            if (entry == keep)
+                break;
+            remove(entry);
+        }
+    }
+
+    typedef HashMap<Key, Entry*, KeyHash, KeyTraits> EntryMap;
+    EntryMap m_entries;
+    ListHashSet<Entry*> m_recentlyUsed;
+
+    size_t m_budget;
+    size_t m_size;
+};
+
+} // namespace WebCore
+
+#endif // BudgetedLRUCacheFymp_h
+
+/* FYWEBKITMOD END */
@@ -71,6 +71,7 @@ public:
         , m_fakeItalic(false)
 #if PLATFORM(FYMP) // FYWEBKITMOD
 		, m_font(0)
+		, m_persistentHash(0)
 #endif
         { }
 
@@ -81,6 +82,7 @@ public:
         , m_fakeItalic(false)
 #if PLATFORM(FYMP) // FYWEBKITMOD
 		, m_font(0)
+		, m_persistentHash(0)
 #endif
         { }
 
@@ -91,6 +93,7 @@ public:
         , m_fakeItalic(fakeItalic)
 #if PLATFORM(FYMP) // FYWEBKITMOD
 		, m_font(0)
+		, m_persistentHash(0)
 #endif
         { }
 
@@ -129,6 +132,15 @@ public:
 
 #if PLATFORM(FYMP) // FYWEBKITMOD
 	FONTfont* font() const { return m_font; }
+
+	// Hash of family, size and style that stays the same across launches, 0
+	// for web fonts. Used as key into the persistent GlyphCacheFymp.
+	unsigned persistentHash() const { return m_persistentHash; }
+
+	// The full key persistentHash() is computed from.
+	const CString& family() const { return m_family; }
+	bool fakeBold() const { return m_fakeBold; }
+	bool fakeItalic() const { return m_fakeItalic; }
 #endif
 
     // -------------------------------------------------------------------------
@@ -152,7 +164,10 @@ private:
     SkTypeface* hashTableDeletedFontValue() const { return reinterpret_cast<SkTypeface*>(-1); }
 
 #if PLATFORM(FYMP) // FYWEBKITMOD
+	void computePersistentHash();
+
 	FONTfont* m_font;
+	unsigned m_persistentHash;
 #endif
 
 };
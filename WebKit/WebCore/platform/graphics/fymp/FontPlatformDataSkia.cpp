@@ -75,6 +75,7 @@ FontPlatformData::FontPlatformData(const FontPlatformData& src)
     , m_style(src.m_style)
 #if PLATFORM(FYMP)
 	, m_font(src.m_font)
+	, m_persistentHash(src.m_persistentHash)
 #endif
 {
     m_typeface->safeRef();
@@ -101,6 +102,7 @@ FontPlatformData::FontPlatformData(SkTypeface* tf, const char* family, float tex
 	flags |= SkTypeface::kItalic;
 
     m_font = SkFontHostFy::GetFont(m_typeface, m_textSize, flags);
+    computePersistentHash();
 }
 
 FontPlatformData::FontPlatformData(const FontPlatformData& src, float textSize)
@@ -120,6 +122,7 @@ FontPlatformData::FontPlatformData(const FontPlatformData& src, float textSize)
 	flags |= SkTypeface::kItalic;
 
     m_font = SkFontHostFy::GetFont(m_typeface, m_textSize, flags);
+    computePersistentHash();
 }
 
 FontPlatformData::~FontPlatformData()
@@ -144,6 +147,7 @@ FontPlatformData& FontPlatformData::operator=(const FontPlatformData& src)
 	m_font = src.m_font;
 	if (m_font)
 		SkFontHostFy::AddFontReference(m_font);
+	m_persistentHash = src.m_persistentHash;
 #endif
 
     return *this;
@@ -227,6 +231,26 @@ unsigned FontPlatformData::hash() const
     return h;
 }
 
+#if PLATFORM(FYMP)
+void FontPlatformData::computePersistentHash()
+{
+    // Web fonts come without a family name and may differ from load to load.
+    if (!m_family.length()) {
+        m_persistentHash = 0;
+        return;
+    }
+
+    unsigned h = StringImpl::computeHash(m_family.data(), m_family.length());
+    h ^= 0x01010101 * ((static_cast<int>(m_fakeBold) << 1) | static_cast<int>(m_fakeItalic));
+
+    uint32_t textSizeBytes;
+    memcpy(&textSizeBytes, &m_textSize, sizeof(uint32_t));
+    h ^= textSizeBytes;
+
+    m_persistentHash = h ? h : 1;
+}
+#endif
+
 bool FontPlatformData::isFixedPitch() const
 {
     notImplemented();
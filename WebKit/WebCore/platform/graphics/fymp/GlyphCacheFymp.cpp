@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#include "config.h"
+#include "GlyphCacheFymp.h"
+
+#include "FontPlatformData.h"
+
+#include <algorithm>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// Image layout (native endianness, the image never leaves the device):
+//
+//   Header
+//   FontEntry[fontCount]      sorted by key
+//   PageEntry[pageCount]      grouped by font, sorted by pageNumber
+//   WidthEntry[widthCount]    grouped by font, sorted by glyph
+//   char[familyLength]        family names referenced by the font entries
+
+static const uint32_t glyphCacheMagic = 0x46594743; // 'FYGC'
+static const uint32_t glyphCacheVersion = 2;
+
+struct GlyphCacheFymp::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fontSetHash;
+    uint32_t fontCount;
+    uint32_t pageCount;
+    uint32_t widthCount;
+    uint32_t familyLength;
+};
+
+struct GlyphCacheFymp::FontEntry {
+    uint32_t key;
+    uint32_t textSizeBits;
+    uint32_t style;
+    uint32_t familyOffset;
+    uint32_t familyLength;
+    uint32_t firstPage;
+    uint32_t pageCount;
+    uint32_t firstWidth;
+    uint32_t widthCount;
+};
+
+struct GlyphCacheFymp::PageEntry {
+    uint32_t pageNumber;
+    uint32_t anyGlyphs;
+    uint16_t glyphs[GlyphPage::size];
+};
+
+struct GlyphCacheFymp::WidthEntry {
+    uint32_t glyph;
+    float width;
+};
+
+static uint32_t textSizeBits(const FontPlatformData& platformData)
+{
+    float textSize = platformData.size();
+    uint32_t bits;
+    memcpy(&bits, &textSize, sizeof(uint32_t));
+    return bits;
+}
+
+static uint32_t styleBits(const FontPlatformData& platformData)
+{
+    return (static_cast<uint32_t>(platformData.fakeBold()) << 1) | static_cast<uint32_t>(platformData.fakeItalic());
+}
+
+static bool sameFace(const CString& family, uint32_t textSize, uint32_t style, const FontPlatformData& platformData)
+{
+    const CString& otherFamily = platformData.family();
+    return textSize == textSizeBits(platformData) && style == styleBits(platformData)
+        && family.length() == otherFamily.length() && !memcmp(family.data(), otherFamily.data(), family.length());
+}
+
+// Checks begin + count <= limit without overflowing.
+static bool rangeFits(uint32_t begin, uint32_t count, uint32_t limit)
+{
+    return count <= limit && begin <= limit - count;
+}
+
+GlyphCacheFymp& GlyphCacheFymp::shared()
+{
+    DEFINE_STATIC_LOCAL(GlyphCacheFymp, cache, ());
+    return cache;
+}
+
+GlyphCacheFymp::GlyphCacheFymp()
+    : m_header(0)
+    , m_fonts(0)
+    , m_pages(0)
+    , m_widths(0)
+    , m_families(0)
+    , m_fontSetHash(0)
+    , m_recording(false)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+bool GlyphCacheFymp::setMappedData(const void* data, unsigned size, unsigned fontSetHash)
+{
+    m_header = 0;
+    m_fonts = 0;
+    m_pages = 0;
+    m_widths = 0;
+    m_families = 0;
+    m_fontSetHash = fontSetHash;
+
+    if (!data || size < sizeof(Header))
+        return false;
+
+    const Header* header = static_cast<const Header*>(data);
+    if (header->magic != glyphCacheMagic || header->version != glyphCacheVersion || header->fontSetHash != fontSetHash)
+        return false;
+
+    // Each section is checked against what is left of the image before
+    // multiplying, so a corrupted count can neither overflow nor point past
+    // the end of the mapping.
+    size_t remaining = size - sizeof(Header);
+    if (header->fontCount > remaining / sizeof(FontEntry))
+        return false;
+    remaining -= header->fontCount * sizeof(FontEntry);
+    if (header->pageCount > remaining / sizeof(PageEntry))
+        return false;
+    remaining -= header->pageCount * sizeof(PageEntry);
+    if (header->widthCount > remaining / sizeof(WidthEntry))
+        return false;
+    remaining -= header->widthCount * sizeof(WidthEntry);
+    if (header->familyLength > remaining)
+        return false;
+
+    const char* cursor = static_cast<const char*>(data) + sizeof(Header);
+    const FontEntry* fonts = reinterpret_cast<const FontEntry*>(cursor);
+    cursor += header->fontCount * sizeof(FontEntry);
+    const PageEntry* pages = reinterpret_cast<const PageEntry*>(cursor);
+    cursor += header->pageCount * sizeof(PageEntry);
+    const WidthEntry* widths = reinterpret_cast<const WidthEntry*>(cursor);
+    cursor += header->widthCount * sizeof(WidthEntry);
+    const char* families = cursor;
+
+    for (unsigned i = 0; i < header->fontCount; ++i) {
+        if (!rangeFits(fonts[i].firstPage, fonts[i].pageCount, header->pageCount)
+            || !rangeFits(fonts[i].firstWidth, fonts[i].widthCount, header->widthCount)
+            || !rangeFits(fonts[i].familyOffset, fonts[i].familyLength, header->familyLength))
+            return false;
+    }
+
+    m_header = header;
+    m_fonts = fonts;
+    m_pages = pages;
+    m_widths = widths;
+    m_families = families;
+    return true;
+}
+
+void GlyphCacheFymp::setRecording(bool recording)
+{
+    m_recording = recording;
+    if (!recording) {
+        deleteAllValues(m_recorded);
+        m_recorded.clear();
+    }
+}
+
+const GlyphCacheFymp::FontEntry* GlyphCacheFymp::findFont(const FontPlatformData& platformData) const
+{
+    unsigned key = platformData.persistentHash();
+    if (!m_header || !key)
+        return 0;
+
+    unsigned low = 0;
+    unsigned high = m_header->fontCount;
+    while (low < high) {
+        unsigned middle = (low + high) / 2;
+        if (m_fonts[middle].key < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    const CString& family = platformData.family();
+    uint32_t textSize = textSizeBits(platformData);
+    uint32_t style = styleBits(platformData);
+    for (; low < m_header->fontCount && m_fonts[low].key == key; ++low) {
+        const FontEntry& font = m_fonts[low];
+        if (font.textSizeBits == textSize && font.style == style && font.familyLength == family.length()
+            && !memcmp(m_families + font.familyOffset, family.data(), family.length()))
+            return &font;
+    }
+    return 0;
+}
+
+GlyphCacheFymp::RecordedFont* GlyphCacheFymp::recordedFont(const FontPlatformData& platformData)
+{
+    unsigned key = platformData.persistentHash();
+    if (!m_recording || !key)
+        return 0;
+
+    RecordedFont*& font = m_recorded.add(key, 0).first->second;
+    if (font) {
+        // Another face with the same hash was recorded first; this one stays uncached.
+        return sameFace(font->family, font->textSizeBits, font->style, platformData) ? font : 0;
+    }
+
+    // serialize() keeps one face per hash, so a face colliding with a mapped
+    // one is not recorded either.
+    if (m_header && !findFont(platformData)) {
+        for (unsigned i = 0; i < m_header->fontCount; ++i) {
+            if (m_fonts[i].key == key) {
+                m_recorded.remove(key);
+                return 0;
+            }
+        }
+    }
+
+    font = new RecordedFont;
+    font->family = platformData.family();
+    font->textSizeBits = textSizeBits(platformData);
+    font->style = styleBits(platformData);
+    return font;
+}
+
+bool GlyphCacheFymp::lookupPage(const FontPlatformData& platformData, unsigned pageNumber, Glyph* glyphs, bool& anyGlyphs) const
+{
+    const FontEntry* font = findFont(platformData);
+    if (font) {
+        const PageEntry* begin = m_pages + font->firstPage;
+        unsigned low = 0;
+        unsigned high = font->pageCount;
+        while (low < high) {
+            unsigned middle = (low + high) / 2;
+            if (begin[middle].pageNumber < pageNumber)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        if (low < font->pageCount && begin[low].pageNumber == pageNumber) {
+            memcpy(glyphs, begin[low].glyphs, sizeof(begin[low].glyphs));
+            anyGlyphs = begin[low].anyGlyphs;
+            ++m_hits;
+            return true;
+        }
+    }
+    ++m_misses;
+    return false;
+}
+
+void GlyphCacheFymp::recordPage(const FontPlatformData& platformData, unsigned pageNumber, const Glyph* glyphs, bool anyGlyphs)
+{
+    RecordedFont* font = recordedFont(platformData);
+    if (!font || font->pageNumbers.find(pageNumber) != notFound)
+        return;
+
+    font->pageNumbers.append(pageNumber);
+    font->glyphs.append(glyphs, GlyphPage::size);
+    font->anyGlyphs.append(anyGlyphs);
+}
+
+bool GlyphCacheFymp::lookupWidth(const FontPlatformData& platformData, Glyph glyph, float& width) const
+{
+    const FontEntry* font = findFont(platformData);
+    if (font) {
+        const WidthEntry* begin = m_widths + font->firstWidth;
+        unsigned low = 0;
+        unsigned high = font->widthCount;
+        while (low < high) {
+            unsigned middle = (low + high) / 2;
+            if (begin[middle].glyph < glyph)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        if (low < font->widthCount && begin[low].glyph == glyph) {
+            width = begin[low].width;
+            ++m_hits;
+            return true;
+        }
+    }
+    ++m_misses;
+    return false;
+}
+
+void GlyphCacheFymp::recordWidth(const FontPlatformData& platformData, Glyph glyph, float width)
+{
+    // Glyph 0 is the empty value of the width map and is cheap to query anyway.
+    if (!glyph)
+        return;
+
+    RecordedFont* font = recordedFont(platformData);
+    if (font)
+        font->widths.set(glyph, width);
+}
+
+namespace {
+
+struct MergedPage {
+    uint32_t pageNumber;
+    uint32_t anyGlyphs;
+    const uint16_t* glyphs;
+
+    bool operator<(const MergedPage& other) const { return pageNumber < other.pageNumber; }
+};
+
+struct MergedWidth {
+    uint32_t glyph;
+    float width;
+
+    bool operator<(const MergedWidth& other) const { return glyph < other.glyph; }
+};
+
+struct MergedFont {
+    uint32_t textSizeBits;
+    uint32_t style;
+    const char* family;
+    uint32_t familyLength;
+    Vector<MergedPage> pages;
+    Vector<MergedWidth> widths;
+};
+
+template<typename T> void appendBytes(Vector<char>& image, const T& value)
+{
+    image.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // namespace
+
+void GlyphCacheFymp::serialize(Vector<char>& image) const
+{
+    HashMap<unsigned, MergedFont*> merged;
+
+    // Mapped entries first; freshly recorded ones only add what is missing.
+    // recordedFont() made sure a hash never stands for two different faces.
+    if (m_header) {
+        for (unsigned i = 0; i < m_header->fontCount; ++i) {
+            const FontEntry& entry = m_fonts[i];
+            if (merged.contains(entry.key))
+                continue;
+            MergedFont* font = new MergedFont;
+            font->textSizeBits = entry.textSizeBits;
+            font->style = entry.style;
+            font->family = m_families + entry.familyOffset;
+            font->familyLength = entry.familyLength;
+            for (unsigned p = 0; p < entry.pageCount; ++p) {
+                const PageEntry& page = m_pages[entry.firstPage + p];
+                MergedPage mergedPage = { page.pageNumber, page.anyGlyphs, page.glyphs };
+                font->pages.append(mergedPage);
+            }
+            for (unsigned w = 0; w < entry.widthCount; ++w) {
+                const WidthEntry& width = m_widths[entry.firstWidth + w];
+                MergedWidth mergedWidth = { width.glyph, width.width };
+                font->widths.append(mergedWidth);
+            }
+            merged.set(entry.key, font);
+        }
+    }
+
+    HashMap<unsigned, RecordedFont*>::const_iterator recordedEnd = m_recorded.end();
+    for (HashMap<unsigned, RecordedFont*>::const_iterator it = m_recorded.begin(); it != recordedEnd; ++it) {
+        const RecordedFont* recorded = it->second;
+        MergedFont*& font = merged.add(it->first, 0).first->second;
+        if (!font) {
+            font = new MergedFont;
+            font->textSizeBits = recorded->textSizeBits;
+            font->style = recorded->style;
+            font->family = recorded->family.data();
+            font->familyLength = recorded->family.length();
+        }
+
+        for (size_t p = 0; p < recorded->pageNumbers.size(); ++p) {
+            bool known = false;
+            for (size_t i = 0; i < font->pages.size() && !known; ++i)
+                known = font->pages[i].pageNumber == recorded->pageNumbers[p];
+            if (known)
+                continue;
+            MergedPage mergedPage = { recorded->pageNumbers[p], recorded->anyGlyphs[p], recorded->glyphs.data() + p * GlyphPage::size };
+            font->pages.append(mergedPage);
+        }
+
+        HashMap<unsigned, float>::const_iterator widthsEnd = recorded->widths.end();
+        for (HashMap<unsigned, float>::const_iterator width = recorded->widths.begin(); width != widthsEnd; ++width) {
+            bool known = false;
+            for (size_t i = 0; i < font->widths.size() && !known; ++i)
+                known = font->widths[i].glyph == width->first;
+            if (known)
+                continue;
+            MergedWidth mergedWidth = { width->first, width->second };
+            font->widths.append(mergedWidth);
+        }
+    }
+
+    Vector<unsigned> keys;
+    HashMap<unsigned, MergedFont*>::const_iterator mergedEnd = merged.end();
+    for (HashMap<unsigned, MergedFont*>::const_iterator it = merged.begin(); it != mergedEnd; ++it)
+        keys.append(it->first);
+    std::sort(keys.begin(), keys.end());
+
+    Header header = { glyphCacheMagic, glyphCacheVersion, m_fontSetHash, static_cast<uint32_t>(keys.size()), 0, 0, 0 };
+    Vector<FontEntry> fonts;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        MergedFont* font = merged.get(keys[i]);
+        std::sort(font->pages.begin(), font->pages.end());
+        std::sort(font->widths.begin(), font->widths.end());
+        FontEntry entry = { keys[i], font->textSizeBits, font->style, header.familyLength, font->familyLength,
+            header.pageCount, static_cast<uint32_t>(font->pages.size()), header.widthCount, static_cast<uint32_t>(font->widths.size()) };
+        fonts.append(entry);
+        header.pageCount += font->pages.size();
+        header.widthCount += font->widths.size();
+        header.familyLength += font->familyLength;
+    }
+
+    image.clear();
+    image.reserveCapacity(sizeof(Header) + header.fontCount * sizeof(FontEntry) + header.pageCount * sizeof(PageEntry) + header.widthCount * sizeof(WidthEntry) + header.familyLength);
+    appendBytes(image, header);
+    for (size_t i = 0; i < fonts.size(); ++i)
+        appendBytes(image, fonts[i]);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const Vector<MergedPage>& pages = merged.get(keys[i])->pages;
+        for (size_t p = 0; p < pages.size(); ++p) {
+            PageEntry entry;
+            entry.pageNumber = pages[p].pageNumber;
+            entry.anyGlyphs = pages[p].anyGlyphs;
+            memcpy(entry.glyphs, pages[p].glyphs, sizeof(entry.glyphs));
+            appendBytes(image, entry);
+        }
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const Vector<MergedWidth>& widths = merged.get(keys[i])->widths;
+        for (size_t w = 0; w < widths.size(); ++w) {
+            WidthEntry entry = { widths[w].glyph, widths[w].width };
+            appendBytes(image, entry);
+        }
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const MergedFont* font = merged.get(keys[i]);
+        image.append(font->family, font->familyLength);
+    }
+
+    deleteAllValues(merged);
+}
+
+} // namespace WebCore
+
+/* FYWEBKITMOD END */
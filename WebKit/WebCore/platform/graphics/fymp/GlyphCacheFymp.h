@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef GlyphCacheFymp_h
+#define GlyphCacheFymp_h
+
+#include "GlyphPageTreeNode.h"
+
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+
+namespace WebCore {
+
+class FontPlatformData;
+
+// Persistent glyph page and advance width cache for the bundled system fonts.
+//
+// The embedder memory-maps a previously serialized cache image and hands it
+// to us with setMappedData(). GlyphPage::fill() and
+// SimpleFontData::platformWidthForGlyph() consult the image before asking
+// SkFontHostFy. While recording is enabled, every page and width we had to
+// compute is collected so the embedder can write out a fresh image with
+// serialize() (e.g. after the first screen is up).
+//
+// The image is only trusted if its font set hash matches the one given by the
+// embedder, which should be a hash over the bundled font files. Individual
+// faces are found by FontPlatformData::persistentHash() and then compared by
+// family, size and style, so a hash collision never hands out another face's
+// glyphs. Web fonts have no persistent key and are never cached.
+class GlyphCacheFymp : public Noncopyable {
+public:
+    static GlyphCacheFymp& shared();
+
+    // The data must stay mapped until setMappedData() is called again.
+    // Returns false (and ignores the data) if the image is malformed or was
+    // built against a different font set.
+    bool setMappedData(const void* data, unsigned size, unsigned fontSetHash);
+
+    void setRecording(bool recording);
+    bool isRecording() const { return m_recording; }
+
+    // Writes the mapped image merged with everything recorded since.
+    void serialize(Vector<char>& image) const;
+
+    // Returns true and fills the 256 glyphs of a BMP page if the page is known.
+    bool lookupPage(const FontPlatformData&, unsigned pageNumber, Glyph* glyphs, bool& anyGlyphs) const;
+    void recordPage(const FontPlatformData&, unsigned pageNumber, const Glyph* glyphs, bool anyGlyphs);
+
+    bool lookupWidth(const FontPlatformData&, Glyph, float& width) const;
+    void recordWidth(const FontPlatformData&, Glyph, float width);
+
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    GlyphCacheFymp();
+
+    struct Header;
+    struct FontEntry;
+    struct PageEntry;
+    struct WidthEntry;
+
+    struct RecordedFont {
+        CString family;
+        uint32_t textSizeBits;
+        uint32_t style;
+        Vector<unsigned> pageNumbers;
+        Vector<Glyph> glyphs;          // GlyphPage::size entries per page number
+        Vector<unsigned char> anyGlyphs;
+        HashMap<unsigned, float> widths;
+    };
+
+    const FontEntry* findFont(const FontPlatformData&) const;
+    RecordedFont* recordedFont(const FontPlatformData&);
+
+    const Header* m_header;
+    const FontEntry* m_fonts;
+    const PageEntry* m_pages;
+    const WidthEntry* m_widths;
+    const char* m_families;
+    unsigned m_fontSetHash;
+
+    bool m_recording;
+    HashMap<unsigned, RecordedFont*> m_recorded;
+
+    mutable unsigned m_hits;
+    mutable unsigned m_misses;
+};
+
+} // namespace WebCore
+
+#endif // GlyphCacheFymp_h
+
+/* FYWEBKITMOD END */
@@ -35,6 +35,7 @@
 #include "GlyphPageTreeNode.h"
 
 #include "Font.h"
+#include "GlyphCacheFymp.h"
 #include "SimpleFontData.h"
 
 #include "SkTemplates.h"
@@ -69,6 +70,21 @@ bool GlyphPage::fill(unsigned offset, unsigned length, UChar* buffer, unsigned b
     }
 	FYASSERT(sizeof(UChar) == sizeof(STDwchar));
 
+	// Whole BMP pages of system fonts may be known from the persistent glyph cache. The last
+	// character of a page is never substituted by GlyphPageTreeNode, so it tells us the page number.
+	GlyphCacheFymp& glyphCache = GlyphCacheFymp::shared();
+	bool bCacheablePage = !offset && length == GlyphPage::size && bufferLength == GlyphPage::size && fontData->platformData().persistentHash();
+	unsigned pageNumber = buffer[GlyphPage::size - 1] / GlyphPage::size;
+	if (bCacheablePage) {
+		Glyph cachedGlyphs[GlyphPage::size];
+		bool bCachedAnyGood;
+		if (glyphCache.lookupPage(fontData->platformData(), pageNumber, cachedGlyphs, bCachedAnyGood)) {
+			for (unsigned i = 0; i < length; ++i)
+				setGlyphDataForIndex(i, cachedGlyphs[i], cachedGlyphs[i] ? fontData : NULL);
+			return bCachedAnyGood;
+		}
+	}
+
 	// note: we always establish a mapping to the very font inside SimpleFontData. BUT: the data present to Webkit
 	// allows for fallback fonts as a pointer to the font is present for each mapping!
 #if !PLATFORM(FYMP_VS) // FYWEBKITMOD VisualStudio build will use new-operator to gain the buffer
@@ -83,6 +99,9 @@ bool GlyphPage::fill(unsigned offset, unsigned length, UChar* buffer, unsigned b
 	for (unsigned i = 0; i < length; ++i)
 		setGlyphDataForIndex(offset + i, glyphs[i], glyphs[i] ? fontData : NULL);
 
+	if (bCacheablePage && glyphCache.isRecording())
+		glyphCache.recordPage(fontData->platformData(), pageNumber, glyphs, bAnyGood);
+
 #if PLATFORM(FYMP_VS)
 	delete[] glyphs;
 #endif
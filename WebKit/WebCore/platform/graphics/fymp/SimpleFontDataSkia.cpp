@@ -38,6 +38,7 @@
 #include "FontCache.h"
 #include "FloatRect.h"
 #include "FontDescription.h"
+#include "GlyphCacheFymp.h"
 #include "Logging.h"
 
 #include "SkFontHost.h"
@@ -154,7 +155,15 @@ FloatRect SimpleFontData::platformBoundsForGlyph(Glyph glyph) const
     
 float SimpleFontData::platformWidthForGlyph(Glyph glyph) const
 {
-    return SkFontHostFy::GetGlyphWidth(m_platformData.font(), glyph);
+    GlyphCacheFymp& glyphCache = GlyphCacheFymp::shared();
+    float width;
+    if (glyphCache.lookupWidth(m_platformData, glyph, width))
+        return width;
+
+    width = SkFontHostFy::GetGlyphWidth(m_platformData.font(), glyph);
+    if (glyphCache.isRecording())
+        glyphCache.recordWidth(m_platformData, glyph, width);
+    return width;
 }
 
 float SimpleFontData::platformKerningPair(Glyph left, Glyph right) const
@@ -0,0 +1,466 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#include "config.h"
+#include "BoxBlurSkia.h"
+
+#include "SkCanvas.h"
+#include "SkDrawLooper.h"
+#include "SkMask.h"
+#include "SkMaskFilter.h"
+#include "SkPaint.h"
+
+#include <math.h>
+#include <string.h>
+#include <wtf/MathExtras.h>
+#include <wtf/Vector.h>
+
+using namespace std;
+
+namespace WebCore {
+
+// Keeps the sum of a window within 16 bits per channel, which lets the 32 bit
+// pass add and subtract two channels with one instruction.
+static const unsigned maxBoxWidth = 255;
+
+static bool s_boxBlurShadowsEnabled = true;
+
+namespace {
+
+struct Box {
+    explicit Box(unsigned width)
+        : left(width / 2)
+        , right(width - width / 2)
+        , scale(((1 << 24) + width / 2) / width)
+    {
+    }
+
+    int left;
+    int right;
+    // 8.24 fixed point reciprocal of the width.
+    uint32_t scale;
+};
+
+inline uint32_t average(uint32_t sum, uint32_t scale)
+{
+    return (sum * scale + (1 << 23)) >> 24;
+}
+
+// Two channels of a premultiplied pixel, each in a 16 bit lane.
+inline uint32_t redBlue(uint32_t pixel)
+{
+    return pixel & 0x00FF00FF;
+}
+
+inline uint32_t alphaGreen(uint32_t pixel)
+{
+    return (pixel >> 8) & 0x00FF00FF;
+}
+
+inline uint32_t averagePixel(uint32_t redBlueSum, uint32_t alphaGreenSum, uint32_t scale)
+{
+    return average(redBlueSum & 0xFFFF, scale)
+        | average(redBlueSum >> 16, scale) << 16
+        | average(alphaGreenSum & 0xFFFF, scale) << 8
+        | average(alphaGreenSum >> 16, scale) << 24;
+}
+
+void blurLineAlpha(const unsigned char* src, unsigned char* dst, int count, const Box& box)
+{
+    uint32_t sum = 0;
+    int kernelEnd = min(box.right, count);
+    for (int i = 0; i < kernelEnd; ++i)
+        sum += src[i];
+
+    for (int x = 0; x < count; ++x) {
+        dst[x] = static_cast<unsigned char>(average(sum, box.scale));
+        if (x >= box.left)
+            sum -= src[x - box.left];
+        if (x + box.right < count)
+            sum += src[x + box.right];
+    }
+}
+
+// Vertical pass over all columns at once. The inner loops run along rows so
+// they touch memory sequentially and have no dependency between iterations.
+void blurColumnsAlpha(const unsigned char* src, int srcRowBytes, unsigned char* dst, int dstRowBytes, int width, int height, const Box& box, uint32_t* sums)
+{
+    memset(sums, 0, width * sizeof(uint32_t));
+    int kernelEnd = min(box.right, height);
+    for (int i = 0; i < kernelEnd; ++i) {
+        const unsigned char* row = src + i * srcRowBytes;
+        for (int x = 0; x < width; ++x)
+            sums[x] += row[x];
+    }
+
+    for (int y = 0; y < height; ++y) {
+        unsigned char* out = dst + y * dstRowBytes;
+        for (int x = 0; x < width; ++x)
+            out[x] = static_cast<unsigned char>(average(sums[x], box.scale));
+        if (y >= box.left) {
+            const unsigned char* row = src + (y - box.left) * srcRowBytes;
+            for (int x = 0; x < width; ++x)
+                sums[x] -= row[x];
+        }
+        if (y + box.right < height) {
+            const unsigned char* row = src + (y + box.right) * srcRowBytes;
+            for (int x = 0; x < width; ++x)
+                sums[x] += row[x];
+        }
+    }
+}
+
+void blurLinePremultiplied(const uint32_t* src, uint32_t* dst, int count, const Box& box)
+{
+    uint32_t redBlueSum = 0;
+    uint32_t alphaGreenSum = 0;
+    int kernelEnd = min(box.right, count);
+    for (int i = 0; i < kernelEnd; ++i) {
+        redBlueSum += redBlue(src[i]);
+        alphaGreenSum += alphaGreen(src[i]);
+    }
+
+    for (int x = 0; x < count; ++x) {
+        dst[x] = averagePixel(redBlueSum, alphaGreenSum, box.scale);
+        if (x >= box.left) {
+            redBlueSum -= redBlue(src[x - box.left]);
+            alphaGreenSum -= alphaGreen(src[x - box.left]);
+        }
+        if (x + box.right < count) {
+            redBlueSum += redBlue(src[x + box.right]);
+            alphaGreenSum += alphaGreen(src[x + box.right]);
+        }
+    }
+}
+
+void blurColumnsPremultiplied(const unsigned char* src, int srcRowBytes, unsigned char* dst, int dstRowBytes, int width, int height, const Box& box, uint32_t* redBlueSums, uint32_t* alphaGreenSums)
+{
+    memset(redBlueSums, 0, width * sizeof(uint32_t));
+    memset(alphaGreenSums, 0, width * sizeof(uint32_t));
+    int kernelEnd = min(box.right, height);
+    for (int i = 0; i < kernelEnd; ++i) {
+        const uint32_t* row = reinterpret_cast<const uint32_t*>(src + i * srcRowBytes);
+        for (int x = 0; x < width; ++x) {
+            redBlueSums[x] += redBlue(row[x]);
+            alphaGreenSums[x] += alphaGreen(row[x]);
+        }
+    }
+
+    for (int y = 0; y < height; ++y) {
+        uint32_t* out = reinterpret_cast<uint32_t*>(dst + y * dstRowBytes);
+        for (int x = 0; x < width; ++x)
+            out[x] = averagePixel(redBlueSums[x], alphaGreenSums[x], box.scale);
+        if (y >= box.left) {
+            const uint32_t* row = reinterpret_cast<const uint32_t*>(src + (y - box.left) * srcRowBytes);
+            for (int x = 0; x < width; ++x) {
+                redBlueSums[x] -= redBlue(row[x]);
+                alphaGreenSums[x] -= alphaGreen(row[x]);
+            }
+        }
+        if (y + box.right < height) {
+            const uint32_t* row = reinterpret_cast<const uint32_t*>(src + (y + box.right) * srcRowBytes);
+            for (int x = 0; x < width; ++x) {
+                redBlueSums[x] += redBlue(row[x]);
+                alphaGreenSums[x] += alphaGreen(row[x]);
+            }
+        }
+    }
+}
+
+class BoxBlurMaskFilter : public SkMaskFilter {
+public:
+    explicit BoxBlurMaskFilter(SkScalar radius)
+        : m_radius(radius)
+    {
+    }
+
+    virtual SkMask::Format getFormat() { return SkMask::kA8_Format; }
+
+    virtual bool filterMask(SkMask* dst, const SkMask& src, const SkMatrix& matrix, SkIPoint* margin)
+    {
+        if (src.fFormat != SkMask::kA8_Format)
+            return false;
+
+        unsigned boxWidth = boxBlurWidth(SkScalarToFloat(matrix.mapRadius(m_radius)));
+        int extent = boxBlurExtent(boxWidth);
+
+        dst->fBounds = src.fBounds;
+        dst->fBounds.inset(-extent, -extent);
+        dst->fRowBytes = dst->fBounds.width();
+        dst->fFormat = SkMask::kA8_Format;
+        dst->fImage = 0;
+        if (margin)
+            margin->set(extent, extent);
+
+        if (!src.fImage)
+            return true;
+
+        size_t size = dst->computeImageSize();
+        if (!size)
+            return false;
+        dst->fImage = SkMask::AllocImage(size);
+        memset(dst->fImage, 0, size);
+
+        int width = src.fBounds.width();
+        int height = src.fBounds.height();
+        for (int y = 0; y < height; ++y)
+            memcpy(dst->fImage + (y + extent) * dst->fRowBytes + extent, src.fImage + y * src.fRowBytes, width);
+
+        boxBlurAlpha(dst->fImage, dst->fBounds.width(), dst->fBounds.height(), dst->fRowBytes, boxWidth, boxWidth);
+        return true;
+    }
+
+    virtual void flatten(SkFlattenableWriteBuffer& buffer)
+    {
+        SkMaskFilter::flatten(buffer);
+        buffer.writeScalar(m_radius);
+    }
+
+    virtual Factory getFactory() { return createProc; }
+
+private:
+    BoxBlurMaskFilter(SkFlattenableReadBuffer& buffer)
+        : SkMaskFilter(buffer)
+        , m_radius(buffer.readScalar())
+    {
+    }
+
+    static SkFlattenable* createProc(SkFlattenableReadBuffer& buffer) { return new BoxBlurMaskFilter(buffer); }
+
+    SkScalar m_radius;
+};
+
+// Same passes as SkBlurDrawLooper: the shadow with the blur color and mask
+// filter at the offset, then the original draw.
+class BoxBlurDrawLooper : public SkDrawLooper {
+public:
+    BoxBlurDrawLooper(SkScalar radius, SkScalar dx, SkScalar dy, SkColor color)
+        : m_canvas(0)
+        , m_paint(0)
+        , m_blur(radius > 0 ? createBoxBlurMaskFilter(radius) : 0)
+        , m_dx(dx)
+        , m_dy(dy)
+        , m_color(color)
+        , m_savedColor(0)
+        , m_saveCount(0)
+        , m_state(Done)
+    {
+    }
+
+    virtual ~BoxBlurDrawLooper()
+    {
+        if (m_blur)
+            m_blur->unref();
+    }
+
+    virtual void init(SkCanvas* canvas, SkPaint* paint)
+    {
+        m_canvas = canvas;
+        m_paint = paint;
+        m_state = BeforeEdge;
+    }
+
+    virtual bool next()
+    {
+        switch (m_state) {
+        case BeforeEdge:
+            m_saveCount = m_canvas->save(SkCanvas::kMatrix_SaveFlag);
+            m_canvas->translate(m_dx, m_dy);
+            m_savedColor = m_paint->getColor();
+            m_paint->setColor(m_color);
+            m_paint->setMaskFilter(m_blur);
+            m_state = AfterEdge;
+            return true;
+        case AfterEdge:
+            restoreState();
+            m_state = Done;
+            return true;
+        case Done:
+            break;
+        }
+        return false;
+    }
+
+    virtual void restore()
+    {
+        if (m_state == AfterEdge) {
+            restoreState();
+            m_state = Done;
+        }
+    }
+
+    virtual void flatten(SkFlattenableWriteBuffer& buffer)
+    {
+        buffer.writeScalar(m_dx);
+        buffer.writeScalar(m_dy);
+        buffer.write32(m_color);
+        buffer.writeFlattenable(m_blur);
+    }
+
+    virtual Factory getFactory() { return createProc; }
+
+private:
+    BoxBlurDrawLooper(SkFlattenableReadBuffer& buffer)
+        : SkDrawLooper(buffer)
+        , m_canvas(0)
+        , m_paint(0)
+        , m_savedColor(0)
+        , m_saveCount(0)
+        , m_state(Done)
+    {
+        m_dx = buffer.readScalar();
+        m_dy = buffer.readScalar();
+        m_color = buffer.readU32();
+        m_blur = static_cast<SkMaskFilter*>(buffer.readFlattenable());
+    }
+
+    static SkFlattenable* createProc(SkFlattenableReadBuffer& buffer) { return new BoxBlurDrawLooper(buffer); }
+
+    void restoreState()
+    {
+        m_paint->setColor(m_savedColor);
+        m_paint->setMaskFilter(0);
+        m_canvas->restoreToCount(m_saveCount);
+    }
+
+    enum State {
+        BeforeEdge,
+        AfterEdge,
+        Done
+    };
+
+    SkCanvas* m_canvas;
+    SkPaint* m_paint;
+    SkMaskFilter* m_blur;
+    SkScalar m_dx;
+    SkScalar m_dy;
+    SkColor m_color;
+    SkColor m_savedColor;
+    int m_saveCount;
+    State m_state;
+};
+
+} // namespace
+
+unsigned boxBlurWidth(float standardDeviation)
+{
+    // Same kernel size as FEGaussianBlur::apply().
+    float width = floorf(standardDeviation * 3 * sqrtf(2 * piFloat) / 4 + 0.5f);
+    if (width < 1)
+        return 1;
+    return min(static_cast<unsigned>(width), maxBoxWidth);
+}
+
+int boxBlurExtent(unsigned boxWidth)
+{
+    // The window reaches boxWidth / 2 pixels to one side and one less to the
+    // other, three times.
+    return 3 * static_cast<int>(boxWidth / 2);
+}
+
+void boxBlurAlpha(unsigned char* pixels, int width, int height, int rowBytes, unsigned boxWidthX, unsigned boxWidthY)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    boxWidthX = min(boxWidthX, maxBoxWidth);
+    boxWidthY = min(boxWidthY, maxBoxWidth);
+
+    if (boxWidthX > 1) {
+        Box box(boxWidthX);
+        Vector<unsigned char> first(width);
+        Vector<unsigned char> second(width);
+        for (int y = 0; y < height; ++y) {
+            unsigned char* row = pixels + y * rowBytes;
+            blurLineAlpha(row, first.data(), width, box);
+            blurLineAlpha(first.data(), second.data(), width, box);
+            blurLineAlpha(second.data(), row, width, box);
+        }
+    }
+
+    if (boxWidthY > 1) {
+        Box box(boxWidthY);
+        Vector<unsigned char> scratch(width * height);
+        Vector<uint32_t> sums(width);
+        blurColumnsAlpha(pixels, rowBytes, scratch.data(), width, width, height, box, sums.data());
+        blurColumnsAlpha(scratch.data(), width, pixels, rowBytes, width, height, box, sums.data());
+        blurColumnsAlpha(pixels, rowBytes, scratch.data(), width, width, height, box, sums.data());
+        for (int y = 0; y < height; ++y)
+            memcpy(pixels + y * rowBytes, scratch.data() + y * width, width);
+    }
+}
+
+void boxBlurPremultiplied(unsigned char* pixels, int width, int height, int rowBytes, unsigned boxWidthX, unsigned boxWidthY)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    boxWidthX = min(boxWidthX, maxBoxWidth);
+    boxWidthY = min(boxWidthY, maxBoxWidth);
+
+    if (boxWidthX > 1) {
+        Box box(boxWidthX);
+        Vector<uint32_t> first(width);
+        Vector<uint32_t> second(width);
+        for (int y = 0; y < height; ++y) {
+            uint32_t* row = reinterpret_cast<uint32_t*>(pixels + y * rowBytes);
+            blurLinePremultiplied(row, first.data(), width, box);
+            blurLinePremultiplied(first.data(), second.data(), width, box);
+            blurLinePremultiplied(second.data(), row, width, box);
+        }
+    }
+
+    if (boxWidthY > 1) {
+        Box box(boxWidthY);
+        int scratchRowBytes = width * sizeof(uint32_t);
+        Vector<unsigned char> scratch(scratchRowBytes * height);
+        Vector<uint32_t> redBlueSums(width);
+        Vector<uint32_t> alphaGreenSums(width);
+        blurColumnsPremultiplied(pixels, rowBytes, scratch.data(), scratchRowBytes, width, height, box, redBlueSums.data(), alphaGreenSums.data());
+        blurColumnsPremultiplied(scratch.data(), scratchRowBytes, pixels, rowBytes, width, height, box, redBlueSums.data(), alphaGreenSums.data());
+        blurColumnsPremultiplied(pixels, rowBytes, scratch.data(), scratchRowBytes, width, height, box, redBlueSums.data(), alphaGreenSums.data());
+        for (int y = 0; y < height; ++y)
+            memcpy(pixels + y * rowBytes, scratch.data() + y * scratchRowBytes, scratchRowBytes);
+    }
+}
+
+SkMaskFilter* createBoxBlurMaskFilter(SkScalar radius)
+{
+    return new BoxBlurMaskFilter(radius);
+}
+
+SkDrawLooper* createBoxBlurDrawLooper(SkScalar radius, SkScalar dx, SkScalar dy, SkColor color)
+{
+    return new BoxBlurDrawLooper(radius, dx, dy, color);
+}
+
+void setBoxBlurShadowsEnabled(bool enabled)
+{
+    s_boxBlurShadowsEnabled = enabled;
+}
+
+bool boxBlurShadowsEnabled()
+{
+    return s_boxBlurShadowsEnabled;
+}
+
+} // namespace WebCore
+
+/* FYWEBKITMOD END */
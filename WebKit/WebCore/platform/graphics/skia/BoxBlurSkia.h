@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef BoxBlurSkia_h
+#define BoxBlurSkia_h
+
+#include "SkColor.h"
+#include "SkScalar.h"
+
+class SkDrawLooper;
+class SkMaskFilter;
+
+namespace WebCore {
+
+// Separable three pass box blur approximating a Gaussian, as described for
+// feGaussianBlur in the SVG spec. Each pass costs a constant number of
+// operations per pixel regardless of the blur size, unlike the generic
+// SkBlurMask path.
+//
+// A box of width d covers d / 2 pixels to the left (or above) and the
+// remaining ones to the right (or below) of the output pixel. Pixels outside
+// the buffer count as transparent, so callers blurring a shape have to leave a
+// transparent margin of boxBlurExtent() pixels around it.
+
+// Box width for a Gaussian of the given standard deviation, at least 1 and at
+// most 255.
+unsigned boxBlurWidth(float standardDeviation);
+
+// How far three passes of a box of the given width reach beyond the source.
+int boxBlurExtent(unsigned boxWidth);
+
+// Blurs an 8 bit alpha buffer in place.
+void boxBlurAlpha(unsigned char* pixels, int width, int height, int rowBytes, unsigned boxWidthX, unsigned boxWidthY);
+
+// Blurs a buffer of premultiplied 32 bit pixels in place. The channel order
+// does not matter, all four channels are blurred the same way.
+void boxBlurPremultiplied(unsigned char* pixels, int width, int height, int rowBytes, unsigned boxWidthX, unsigned boxWidthY);
+
+// Mask filter blurring with boxBlurAlpha(). |radius| is the blur radius
+// SkBlurMaskFilter would get and is used as the standard deviation; it is
+// scaled by the CTM like SkBlurMaskFilter does.
+SkMaskFilter* createBoxBlurMaskFilter(SkScalar radius);
+
+// Replacement for SkBlurDrawLooper that blurs through createBoxBlurMaskFilter().
+SkDrawLooper* createBoxBlurDrawLooper(SkScalar radius, SkScalar dx, SkScalar dy, SkColor);
+
+// The box blur is used for all shadows unless the host turns it off, e.g. to
+// compare against SkBlurDrawLooper.
+void setBoxBlurShadowsEnabled(bool);
+bool boxBlurShadowsEnabled();
+
+} // namespace WebCore
+
+#endif // BoxBlurSkia_h
+
+/* FYWEBKITMOD END */
@@ -33,6 +33,7 @@
 #include "GraphicsContext.h"
 
 #include "AffineTransform.h"
+#include "BoxBlurSkia.h" // FYWEBKITMOD
 #include "Color.h"
 #include "FloatRect.h"
 #include "Gradient.h"
@@ -42,7 +43,9 @@
 #include "IntRect.h"
 #include "NativeImageSkia.h"
 #include "NotImplemented.h"
+#include "PathCacheSkia.h" // FYWEBKITMOD
 #include "PlatformContextSkia.h"
+#include "ShadowCacheSkia.h" // FYWEBKITMOD
 
 #include "SkBitmap.h"
 #include "SkBlurDrawLooper.h"
@@ -214,6 +217,32 @@ void addCornerArc(SkPath* path, const SkRect& rect, const IntSize& size, int sta
     path->arcTo(r, SkIntToScalar(startAngle), SkIntToScalar(90), false);
 }
 
+/* FYWEBKITMOD BEGIN */
+// Paints the shadow of a rect or rounded rect from ShadowCacheSkia instead of
+// letting the draw looper blur the shape again. Only untransformed page
+// content qualifies; canvas shadows ignore the CTM and keep using the looper.
+// On success the caller has to paint the shape itself without the looper.
+bool drawCachedShadow(PlatformContextSkia* context, const SkRect& rect, const IntSize* radii, const GraphicsContextState& state)
+{
+    if (!context->getDrawLooper() || state.shadowsIgnoreTransforms || state.shadowBlur <= 0)
+        return false;
+
+    SkCanvas* canvas = context->canvas();
+    if (canvas->getTotalMatrix().getType() & ~SkMatrix::kTranslate_Mask)
+        return false;
+
+    SkColor color;
+    if (state.shadowColor.isValid())
+        color = state.shadowColor.rgb();
+    else
+        color = SkColorSetARGB(0xFF/3, 0, 0, 0); // See setPlatformShadow().
+
+    SkPaint paint;
+    context->setupPaintCommon(&paint);
+    return ShadowCacheSkia::shared().drawShadow(canvas, rect, radii, state.shadowSize, state.shadowBlur, color, paint);
+}
+/* FYWEBKITMOD END */
+
 // -----------------------------------------------------------------------------
 
 // This may be called with a NULL pointer to create a graphics context that has
@@ -731,6 +760,8 @@ void GraphicsContext::fillPath()
     SkPaint paint;
     platformContext()->setupPaintForFilling(&paint);
 
+    if (PathCacheSkia::shared().drawPath(platformContext()->canvas(), path, paint)) // FYWEBKITMOD
+        return; // FYWEBKITMOD
     platformContext()->canvas()->drawPath(path, paint);
 }
 
@@ -777,6 +808,10 @@ void GraphicsContext::fillRect(const FloatRect& rect, const Color& color, ColorS
     SkPaint paint;
     platformContext()->setupPaintCommon(&paint);
     paint.setColor(color.rgb());
+    /* FYWEBKITMOD BEGIN */
+    if (drawCachedShadow(platformContext(), r, 0, m_common->state))
+        paint.setLooper(0);
+    /* FYWEBKITMOD END */
     platformContext()->canvas()->drawRect(r, paint);
 }
 
@@ -815,6 +850,11 @@ void GraphicsContext::fillRoundedRect(const IntRect& rect,
 
     SkPaint paint;
     platformContext()->setupPaintForFilling(&paint);
+    /* FYWEBKITMOD BEGIN */
+    IntSize radii[4] = { topLeft, topRight, bottomLeft, bottomRight };
+    if (drawCachedShadow(platformContext(), r, radii, m_common->state))
+        paint.setLooper(0);
+    /* FYWEBKITMOD END */
     platformContext()->canvas()->drawPath(path, paint);
 }
 
@@ -1039,7 +1079,13 @@ void GraphicsContext::setPlatformShadow(const FloatSize& size,
 
     // TODO(tc): Should we have a max value for the blur?  CG clamps at 1000.0
     // for perf reasons.
-    SkDrawLooper* dl = new SkBlurDrawLooper(blur / 2, width, height, c);
+    /* FYWEBKITMOD BEGIN */
+    SkDrawLooper* dl;
+    if (boxBlurShadowsEnabled())
+        dl = createBoxBlurDrawLooper(blur / 2, width, height, c);
+    else
+        dl = new SkBlurDrawLooper(blur / 2, width, height, c);
+    /* FYWEBKITMOD END */
     platformContext()->setDrawLooper(dl);
     dl->unref();
 }
@@ -1142,6 +1188,8 @@ void GraphicsContext::strokePath()
 
     SkPaint paint;
     platformContext()->setupPaintForStroking(&paint, 0, 0);
+    if (PathCacheSkia::shared().drawPath(platformContext()->canvas(), path, paint)) // FYWEBKITMOD
+        return; // FYWEBKITMOD
     platformContext()->canvas()->drawPath(path, paint);
 }
 
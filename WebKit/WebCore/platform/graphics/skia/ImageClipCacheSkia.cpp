@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#include "config.h"
+#include "ImageClipCacheSkia.h"
+
+#include "SkColorPriv.h"
+
+#include <algorithm>
+#include <string.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// A few screens worth of text clip masks.
+static const size_t defaultBudget = 1024 * 1024;
+
+// Larger images take longer to read than the layer saves.
+static const size_t maxImageArea = 1024 * 1024;
+
+// Regions with more rects than this are slower to clip against than the layer.
+static const int maxRegionRects = 2048;
+
+ImageClipCacheSkia& ImageClipCacheSkia::shared()
+{
+    DEFINE_STATIC_LOCAL(ImageClipCacheSkia, cache, ());
+    return cache;
+}
+
+ImageClipCacheSkia::ImageClipCacheSkia()
+    : m_entries(defaultBudget)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+// Copies the alpha of |image| into m_scratch and returns a hash of it.
+unsigned ImageClipCacheSkia::extractAlpha(const SkBitmap& image)
+{
+    const int width = image.width();
+    const int height = image.height();
+    m_scratch.resize(width * height);
+
+    unsigned hash = 2166136261U;
+    uint8_t* alpha = m_scratch.data();
+    for (int y = 0; y < height; ++y) {
+        const SkPMColor* row = image.getAddr32(0, y);
+        for (int x = 0; x < width; ++x) {
+            const uint8_t value = SkGetPackedA32(row[x]);
+            *alpha++ = value;
+            hash = (hash ^ value) * 16777619U;
+        }
+    }
+    return hash;
+}
+
+const ImageClipCacheSkia::Mask* ImageClipCacheSkia::maskFor(const SkBitmap& image)
+{
+    if (image.config() != SkBitmap::kARGB_8888_Config || image.empty())
+        return 0;
+    if (static_cast<size_t>(image.width()) * image.height() > maxImageArea)
+        return 0;
+
+    SkAutoLockPixels imageLock(image);
+    if (!image.getPixels())
+        return 0;
+
+    Key key;
+    key.alphaHash = extractAlpha(image);
+    key.width = image.width();
+    key.height = image.height();
+
+    if (Entry* entry = m_entries.find(key)) {
+        SkAutoLockPixels entryLock(entry->alpha);
+        if (!memcmp(entry->alpha.getPixels(), m_scratch.data(), m_scratch.size())) {
+            ++m_hits;
+            return entry;
+        }
+        // Hash collision, the newer mask takes over the slot.
+        m_entries.remove(entry);
+    }
+
+    ++m_misses;
+    return createEntry(key);
+}
+
+ImageClipCacheSkia::Entry* ImageClipCacheSkia::createEntry(const Key& key)
+{
+    const int width = key.width;
+    const int height = key.height;
+
+    Entry* entry = new Entry;
+    entry->key = key;
+    entry->alpha.setConfig(SkBitmap::kA8_Config, width, height);
+    if (!entry->alpha.allocPixels()) {
+        delete entry;
+        return 0;
+    }
+    {
+        SkAutoLockPixels lock(entry->alpha);
+        memcpy(entry->alpha.getPixels(), m_scratch.data(), m_scratch.size());
+    }
+
+    int left = width;
+    int top = height;
+    int right = 0;
+    int bottom = 0;
+    bool binary = true;
+    bool hasHoles = false;
+    const uint8_t* alpha = m_scratch.data();
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = alpha + y * width;
+        for (int x = 0; x < width; ++x) {
+            if (!row[x])
+                continue;
+            if (row[x] != 255)
+                binary = false;
+            left = std::min(left, x);
+            right = std::max(right, x + 1);
+            top = std::min(top, y);
+            bottom = y + 1;
+        }
+    }
+    if (left < right)
+        entry->bounds.set(left, top, right, bottom);
+    else
+        entry->bounds.setEmpty();
+    entry->binary = binary;
+
+    // Inside the bounds, a binary mask is opaque unless it has holes.
+    Vector<SkIRect> rects;
+    bool complex = false;
+    if (binary) {
+        // One rect per run of opaque pixels; runs that continue the same run
+        // of the previous row extend its rect instead.
+        Vector<size_t> previousRow;
+        Vector<size_t> currentRow;
+        for (int y = entry->bounds.fTop; y < entry->bounds.fBottom && !complex; ++y) {
+            const uint8_t* row = alpha + y * width;
+            currentRow.clear();
+            size_t previous = 0;
+            for (int x = entry->bounds.fLeft; x < entry->bounds.fRight; ) {
+                if (!row[x]) {
+                    hasHoles = true;
+                    ++x;
+                    continue;
+                }
+                int runEnd = x + 1;
+                while (runEnd < entry->bounds.fRight && row[runEnd])
+                    ++runEnd;
+
+                while (previous < previousRow.size() && rects[previousRow[previous]].fLeft < x)
+                    ++previous;
+                if (previous < previousRow.size() && rects[previousRow[previous]].fLeft == x && rects[previousRow[previous]].fRight == runEnd
+                    && rects[previousRow[previous]].fBottom == y) {
+                    rects[previousRow[previous]].fBottom = y + 1;
+                    currentRow.append(previousRow[previous]);
+                } else {
+                    SkIRect rect;
+                    rect.set(x, y, runEnd, y + 1);
+                    rects.append(rect);
+                    currentRow.append(rects.size() - 1);
+                    if (rects.size() > static_cast<size_t>(maxRegionRects))
+                        complex = true;
+                }
+                x = runEnd;
+            }
+            previousRow.swap(currentRow);
+        }
+    }
+    entry->opaqueBounds = binary && !hasHoles && !complex;
+    entry->hasRegion = binary && !complex && !entry->opaqueBounds;
+    if (entry->hasRegion)
+        entry->region.setRects(rects.data(), rects.size());
+
+    entry->cost = sizeof(Entry) + entry->alpha.getSize() + (entry->hasRegion ? rects.size() * sizeof(SkIRect) : 0);
+    m_entries.add(entry);
+
+    return entry;
+}
+
+} // namespace WebCore
+
+/* FYWEBKITMOD END */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef ImageClipCacheSkia_h
+#define ImageClipCacheSkia_h
+
+#include "BudgetedLRUCacheFymp.h"
+
+#include "SkBitmap.h"
+#include "SkRect.h"
+#include "SkRegion.h"
+
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Analyzed alpha of the images passed to GraphicsContext::clipToImageBuffer().
+//
+// Skia can't clip to an image, so PlatformContextSkia paints into a full
+// color layer and multiplies it with the image's alpha on restore. Most clip
+// images don't need that: text and shape masks are empty around their
+// content, and masks without antialiasing only ever have alpha 0 or 255,
+// which Skia can express as a native clip region. Each image is reduced to an
+// A8 copy of its alpha together with those properties.
+//
+// Callers tend to rebuild the same mask for every draw, so masks are cached
+// by content: a lookup still reads the image once, but identical alpha finds
+// the mask (and its region) from the last time. Entries are evicted in least
+// recently used order once their total size exceeds budget().
+class ImageClipCacheSkia : public Noncopyable {
+public:
+    static ImageClipCacheSkia& shared();
+
+    struct Mask {
+        SkBitmap alpha; // A8 copy of the image's alpha
+        SkIRect bounds; // pixels with non-zero alpha, empty if there are none
+        bool binary; // every alpha is either 0 or 255
+        bool opaqueBounds; // every pixel inside |bounds| has alpha 255
+        bool hasRegion;
+        SkRegion region; // pixels with alpha 255, for binary masks that aren't too complex
+    };
+
+    // Returns the mask for |image|, or 0 if the image can't be analyzed. The
+    // mask stays valid until the next call.
+    const Mask* maskFor(const SkBitmap& image);
+
+    void setBudget(size_t bytes) { m_entries.setBudget(bytes); }
+    size_t budget() const { return m_entries.budget(); }
+    size_t size() const { return m_entries.size(); }
+
+    void clear() { m_entries.clear(); }
+
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    ImageClipCacheSkia();
+
+    struct Key {
+        unsigned hash() const { return alphaHash; }
+        bool operator==(const Key& other) const { return alphaHash == other.alphaHash && width == other.width && height == other.height; }
+        // Images are never empty, so a zero width marks the empty bucket and a
+        // negative one the deleted bucket.
+        bool isHashTableDeletedValue() const { return width == -1; }
+        void setHashTableDeletedValue() { width = -1; }
+
+        unsigned alphaHash;
+        int width;
+        int height;
+    };
+
+    struct Entry : Mask {
+        Key key;
+        size_t cost;
+    };
+
+    unsigned extractAlpha(const SkBitmap& image);
+    Entry* createEntry(const Key&);
+
+    BudgetedLRUCacheFymp<Key, Entry> m_entries;
+    Vector<uint8_t> m_scratch;
+
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+} // namespace WebCore
+
+#endif // ImageClipCacheSkia_h
+
+/* FYWEBKITMOD END */
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#include "config.h"
+#include "PathCacheSkia.h"
+
+#include "SkCanvas.h"
+#include "SkMatrix.h"
+#include "SkPaint.h"
+
+#include <string.h>
+#include <wtf/HashFunctions.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// Room for a few hundred distinct icons.
+static const size_t defaultBudget = 1024 * 1024;
+
+// Larger paths are rarely repeated and take too long to hash for no gain.
+static const int maxMaskArea = 128 * 128;
+
+static uint32_t scalarBits(SkScalar value)
+{
+    float floatValue = SkScalarToFloat(value);
+    uint32_t bits;
+    memcpy(&bits, &floatValue, sizeof(bits));
+    return bits;
+}
+
+static inline unsigned addToHash(unsigned hash, uint32_t value)
+{
+    return WTF::intHash(static_cast<uint64_t>(hash) << 32 | value);
+}
+
+// Device bounds of the mask for |path| drawn with |paint| at |scale|. Returns
+// false for paths whose mask would be too large to be worth caching.
+static bool maskBounds(const SkPath& path, const SkPaint& paint, const SkMatrix& scale, SkIRect& deviceBounds)
+{
+    SkRect storage;
+    SkRect bounds = paint.computeFastBounds(path.getBounds(), &storage);
+    scale.mapRect(&bounds);
+    bounds.roundOut(&deviceBounds);
+    // Antialiasing reaches half a pixel beyond the bounds.
+    deviceBounds.inset(-1, -1);
+    if (deviceBounds.isEmpty())
+        return false;
+    // Huge paths would overflow the product of width and height.
+    return deviceBounds.width() <= maxMaskArea && deviceBounds.height() <= maxMaskArea
+        && deviceBounds.width() * deviceBounds.height() <= maxMaskArea;
+}
+
+static unsigned hashPath(const SkPath& path)
+{
+    // Number of points each verb adds; Iter::next() also returns the
+    // previous point for lines and curves.
+    static const int newPoints[] = { 1, 1, 2, 3, 0, 0 };
+
+    unsigned hash = 0;
+    SkPath::Iter iter(path, false);
+    SkPoint points[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(points)) != SkPath::kDone_Verb) {
+        hash = addToHash(hash, verb);
+        int first = verb == SkPath::kMove_Verb ? 0 : 1;
+        for (int i = first; i < first + newPoints[verb]; ++i) {
+            hash = addToHash(hash, scalarBits(points[i].fX));
+            hash = addToHash(hash, scalarBits(points[i].fY));
+        }
+    }
+    return hash;
+}
+
+PathCacheSkia& PathCacheSkia::shared()
+{
+    DEFINE_STATIC_LOCAL(PathCacheSkia, cache, ());
+    return cache;
+}
+
+PathCacheSkia::PathCacheSkia()
+    : m_entries(defaultBudget)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+unsigned PathCacheSkia::Key::hash() const
+{
+    unsigned hash = pathHash;
+    hash = addToHash(hash, scaleX);
+    hash = addToHash(hash, scaleY);
+    hash = addToHash(hash, strokeWidth);
+    hash = addToHash(hash, strokeMiter);
+    return addToHash(hash, flags);
+}
+
+bool PathCacheSkia::Key::operator==(const Key& other) const
+{
+    return pathHash == other.pathHash && scaleX == other.scaleX && scaleY == other.scaleY
+        && strokeWidth == other.strokeWidth && strokeMiter == other.strokeMiter && flags == other.flags;
+}
+
+bool PathCacheSkia::drawPath(SkCanvas* canvas, const SkPath& path, const SkPaint& paint)
+{
+    if (!m_entries.budget() || path.isEmpty())
+        return false;
+
+    // Anything that shades per pixel or changes the shape outside the path
+    // itself has to go through Skia.
+    if (paint.getShader() || paint.getLooper() || paint.getMaskFilter() || paint.getPathEffect() || paint.getRasterizer())
+        return false;
+
+    // The mask is only valid at the scale it was rasterized with and at
+    // integral device offsets.
+    const SkMatrix& matrix = canvas->getTotalMatrix();
+    if (matrix.getType() & ~(SkMatrix::kTranslate_Mask | SkMatrix::kScale_Mask))
+        return false;
+    SkScalar translateX = matrix.getTranslateX();
+    SkScalar translateY = matrix.getTranslateY();
+    if (SkScalarFraction(translateX) || SkScalarFraction(translateY))
+        return false;
+
+    // Large paths never get a mask, don't spend a hash and an entry on them.
+    SkMatrix scale;
+    scale.setScale(matrix.getScaleX(), matrix.getScaleY());
+    SkIRect deviceBounds;
+    if (!maskBounds(path, paint, scale, deviceBounds))
+        return false;
+
+    Key key;
+    key.pathHash = hashPath(path);
+    key.scaleX = scalarBits(matrix.getScaleX());
+    key.scaleY = scalarBits(matrix.getScaleY());
+    bool stroked = paint.getStyle() != SkPaint::kFill_Style;
+    key.strokeWidth = stroked ? scalarBits(paint.getStrokeWidth()) : 0;
+    key.strokeMiter = stroked ? scalarBits(paint.getStrokeMiter()) : 0;
+    key.flags = 1u << 31 | path.getFillType() | paint.getStyle() << 2 | paint.isAntiAlias() << 4;
+    if (stroked)
+        key.flags |= paint.getStrokeCap() << 5 | paint.getStrokeJoin() << 7;
+
+    Entry* entry = m_entries.find(key);
+    if (entry && !(entry->path == path)) {
+        // Hash collision, the newer path takes over the slot.
+        m_entries.remove(entry);
+        entry = 0;
+    }
+
+    if (!entry) {
+        // First sighting: remember the path, but let the caller draw it.
+        ++m_misses;
+        createEntry(key, path);
+        return false;
+    }
+
+    if (entry->mask.isNull()) {
+        ++m_misses;
+        if (!rasterize(entry, deviceBounds, scale, path, paint)) {
+            m_entries.remove(entry);
+            return false;
+        }
+    } else
+        ++m_hits;
+
+    // The mask is drawn in the paint's color, like Skia blits the coverage of
+    // the path itself.
+    SkPaint maskPaint;
+    maskPaint.setColor(paint.getColor());
+    maskPaint.setXfermode(paint.getXfermode());
+    maskPaint.setColorFilter(paint.getColorFilter());
+
+    canvas->save(SkCanvas::kMatrix_SaveFlag);
+    canvas->resetMatrix();
+    canvas->drawBitmap(entry->mask, translateX + SkIntToScalar(entry->left), translateY + SkIntToScalar(entry->top), &maskPaint);
+    canvas->restore();
+
+    return true;
+}
+
+PathCacheSkia::Entry* PathCacheSkia::createEntry(const Key& key, const SkPath& path)
+{
+    Entry* entry = new Entry;
+    entry->key = key;
+    entry->path = path;
+    entry->left = 0;
+    entry->top = 0;
+    entry->cost = sizeof(Entry) + path.countPoints() * sizeof(SkPoint);
+    m_entries.add(entry);
+
+    return entry;
+}
+
+bool PathCacheSkia::rasterize(Entry* entry, const SkIRect& deviceBounds, const SkMatrix& scale, const SkPath& path, const SkPaint& paint)
+{
+    SkBitmap& mask = entry->mask;
+    mask.setConfig(SkBitmap::kA8_Config, deviceBounds.width(), deviceBounds.height());
+    if (!mask.allocPixels()) {
+        mask.reset();
+        return false;
+    }
+    mask.eraseARGB(0, 0, 0, 0);
+
+    SkMatrix maskMatrix(scale);
+    maskMatrix.postTranslate(SkIntToScalar(-deviceBounds.fLeft), SkIntToScalar(-deviceBounds.fTop));
+
+    SkPaint coveragePaint(paint);
+    coveragePaint.setColor(SK_ColorBLACK);
+    coveragePaint.setXfermode(0);
+    coveragePaint.setColorFilter(0);
+
+    SkCanvas canvas(mask);
+    canvas.setMatrix(maskMatrix);
+    canvas.drawPath(path, coveragePaint);
+
+    entry->left = deviceBounds.fLeft;
+    entry->top = deviceBounds.fTop;
+    m_entries.addCost(entry, mask.getSize());
+
+    return true;
+}
+
+} // namespace WebCore
+
+/* FYWEBKITMOD END */
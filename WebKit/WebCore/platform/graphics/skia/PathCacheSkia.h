@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef PathCacheSkia_h
+#define PathCacheSkia_h
+
+#include "BudgetedLRUCacheFymp.h"
+
+#include "SkBitmap.h"
+#include "SkPath.h"
+
+#include <wtf/Noncopyable.h>
+
+class SkCanvas;
+class SkPaint;
+
+namespace WebCore {
+
+// Cache of rasterized path coverage.
+//
+// Pages full of identical icons (inline SVG or canvas drawn) rasterize the
+// same small path with the same style over and over. The antialiased coverage
+// of a path only depends on its geometry, the fill rule, the stroke style and
+// the scale it is drawn at; we keep it as an A8 mask and draw later instances
+// by blitting the mask in the current color. The position only has to be an
+// integral device offset for the result to be identical.
+//
+// A path gets rasterized into the cache the second time it is seen, so that
+// paths drawn only once (most canvas animation) don't pay for the extra
+// bitmap. Entries are evicted in least recently used order once their total
+// size exceeds budget().
+class PathCacheSkia : public Noncopyable {
+public:
+    static PathCacheSkia& shared();
+
+    // Draws |path| with |paint| on |canvas| from the cache. Returns false
+    // without drawing if the path or paint don't qualify; the caller then has
+    // to draw the path itself.
+    bool drawPath(SkCanvas*, const SkPath&, const SkPaint&);
+
+    void setBudget(size_t bytes) { m_entries.setBudget(bytes); }
+    size_t budget() const { return m_entries.budget(); }
+    size_t size() const { return m_entries.size(); }
+
+    void clear() { m_entries.clear(); }
+
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    PathCacheSkia();
+
+    struct Key {
+        unsigned hash() const;
+        bool operator==(const Key&) const;
+        // Real keys only use the low bits of |flags| next to the marker bit.
+        bool isHashTableDeletedValue() const { return flags == 0xFFFFFFFF; }
+        void setHashTableDeletedValue() { flags = 0xFFFFFFFF; }
+
+        unsigned pathHash;
+        // Raw bits of the scale and stroke parameters, see makeKey().
+        uint32_t scaleX;
+        uint32_t scaleY;
+        uint32_t strokeWidth;
+        uint32_t strokeMiter;
+        // Fill type, style, cap, join and antialiasing packed together; never
+        // zero, so a zero key is the empty bucket.
+        unsigned flags;
+    };
+
+    struct Entry {
+        Key key;
+        // Kept to tell hash collisions apart.
+        SkPath path;
+        // Empty until the path is seen a second time.
+        SkBitmap mask;
+        // Device offset of the mask relative to the integral translation.
+        int left;
+        int top;
+        size_t cost;
+    };
+
+    Entry* createEntry(const Key&, const SkPath&);
+    bool rasterize(Entry*, const SkIRect& deviceBounds, const SkMatrix&, const SkPath&, const SkPaint&);
+
+    BudgetedLRUCacheFymp<Key, Entry> m_entries;
+
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+} // namespace WebCore
+
+#endif // PathCacheSkia_h
+
+/* FYWEBKITMOD END */
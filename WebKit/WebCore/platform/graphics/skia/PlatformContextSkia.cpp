@@ -33,6 +33,7 @@
 
 #include "GraphicsContext.h"
 #include "ImageBuffer.h"
+#include "ImageClipCacheSkia.h" // FYWEBKITMOD
 #include "NativeImageSkia.h"
 #include "PlatformContextSkia.h"
 #include "SkiaUtils.h"
@@ -255,6 +256,10 @@ void PlatformContextSkia::beginLayerClippedToImage(const WebCore::FloatRect& rec
                       SkFloatToScalar(rect.right()), SkFloatToScalar(rect.bottom()) };
 
     canvas()->clipRect(bounds);
+    /* FYWEBKITMOD BEGIN */
+    if (clipToImageNatively(rect, *imageBuffer->context()->platformContext()->bitmap(), &bounds))
+        return;
+    /* FYWEBKITMOD END */
     canvas()->saveLayerAlpha(&bounds, 255,
                              static_cast<SkCanvas::SaveFlags>(SkCanvas::kHasAlphaLayer_SaveFlag | SkCanvas::kFullColorLayer_SaveFlag));
     // Copy off the image as |imageBuffer| may be deleted before restore is invoked.
@@ -274,8 +279,116 @@ void PlatformContextSkia::beginLayerClippedToImage(const WebCore::FloatRect& rec
 }
 #endif
 
+/* FYWEBKITMOD BEGIN */
+#if OS(LINUX) || OS(WINDOWS)
+// Applies the clip image at |rect| as a native clip where its alpha allows.
+// Returns false if a layer is still needed; |bounds| is then narrowed to the
+// part of the image that isn't transparent.
+bool PlatformContextSkia::clipToImageNatively(const WebCore::FloatRect& rect, const SkBitmap& image, SkRect* bounds)
+{
+    const WebCore::ImageClipCacheSkia::Mask* mask = WebCore::ImageClipCacheSkia::shared().maskFor(image);
+    if (!mask)
+        return false;
+
+    if (mask->bounds.isEmpty()) {
+        // Nothing shows through.
+        canvas()->clipRect(SkRect::MakeEmpty());
+        return true;
+    }
+
+    SkRect maskBounds;
+    maskBounds.set(mask->bounds);
+    maskBounds.offset(SkFloatToScalar(rect.x()), SkFloatToScalar(rect.y()));
+    if (mask->opaqueBounds) {
+        canvas()->clipRect(maskBounds);
+        return true;
+    }
+
+    // The region is in device pixels, so it only fits if the image lands on
+    // whole pixels.
+    const SkMatrix& matrix = canvas()->getTotalMatrix();
+    if (mask->hasRegion && !(matrix.getType() & ~SkMatrix::kTranslate_Mask)) {
+        SkScalar x = matrix.getTranslateX() + SkFloatToScalar(rect.x());
+        SkScalar y = matrix.getTranslateY() + SkFloatToScalar(rect.y());
+        if (!SkScalarFraction(x) && !SkScalarFraction(y)) {
+            SkRegion deviceRegion;
+            mask->region.translate(SkScalarRound(x), SkScalarRound(y), &deviceRegion);
+            canvas()->clipRect(maskBounds);
+            canvas()->clipRegion(deviceRegion);
+            return true;
+        }
+    }
+
+    if (!bounds->intersect(maskBounds))
+        bounds->setEmpty();
+    canvas()->clipRect(*bounds);
+    return false;
+}
+#endif
+/* FYWEBKITMOD END */
+
+/* FYWEBKITMOD BEGIN */
+// Recognizes the paths of canvas rect() and Path::createRectangle(): four axis
+// aligned edges, alternating between horizontal and vertical.
+static bool isAxisAlignedRect(const SkPath& path, SkRect* rect)
+{
+    SkPoint corners[5];
+    int count = 0;
+    SkPath::Iter iter(path, false);
+    SkPoint points[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(points)) != SkPath::kDone_Verb) {
+        if (verb == SkPath::kMove_Verb) {
+            if (count)
+                return false;
+            corners[count++] = points[0];
+        } else if (verb == SkPath::kLine_Verb) {
+            if (count == 5)
+                return false;
+            corners[count++] = points[1];
+        } else if (verb != SkPath::kClose_Verb)
+            return false;
+    }
+    if (count == 5 && corners[4] == corners[0])
+        --count;
+    if (count != 4)
+        return false;
+
+    for (int i = 0; i < 4; ++i) {
+        const SkPoint& a = corners[i];
+        const SkPoint& b = corners[(i + 1) % 4];
+        const SkPoint& c = corners[(i + 2) % 4];
+        const bool vertical = a.fX == b.fX && a.fY != b.fY;
+        const bool horizontal = a.fY == b.fY && a.fX != b.fX;
+        const bool nextVertical = b.fX == c.fX && b.fY != c.fY;
+        if (!(vertical || horizontal) || vertical == nextVertical)
+            return false;
+    }
+
+    rect->set(corners[0].fX, corners[0].fY, corners[2].fX, corners[2].fY);
+    rect->sort();
+    return true;
+}
+/* FYWEBKITMOD END */
+
 void PlatformContextSkia::clipPathAntiAliased(const SkPath& clipPath)
 {
+    /* FYWEBKITMOD BEGIN */
+    // A rect that lands on whole device pixels clips the same with Skia's
+    // aliased clip, without the layer.
+    SkRect rect;
+    const SkMatrix& matrix = canvas()->getTotalMatrix();
+    if (!clipPath.isInverseFillType() && isAxisAlignedRect(clipPath, &rect) && !(matrix.getType() & ~(SkMatrix::kTranslate_Mask | SkMatrix::kScale_Mask))) {
+        SkRect deviceRect;
+        matrix.mapRect(&deviceRect, rect);
+        if (!SkScalarFraction(deviceRect.fLeft) && !SkScalarFraction(deviceRect.fTop)
+            && !SkScalarFraction(deviceRect.fRight) && !SkScalarFraction(deviceRect.fBottom)) {
+            canvas()->clipRect(rect);
+            return;
+        }
+    }
+    /* FYWEBKITMOD END */
+
     // If we are currently tracking any anti-alias clip paths, then we already
     // have a layer in place and don't need to add another.
     bool haveLayerOutstanding = m_state->m_antiAliasClipPaths.size();
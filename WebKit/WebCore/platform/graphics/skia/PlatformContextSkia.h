@@ -180,6 +180,7 @@ private:
     // Used when restoring and the state has an image clip. Only shows the pixels in
     // m_canvas that are also in imageBuffer.
     void applyClipFromImage(const WebCore::FloatRect&, const SkBitmap&);
+    bool clipToImageNatively(const WebCore::FloatRect&, const SkBitmap&, SkRect* bounds); // FYWEBKITMOD
 #endif
     void applyAntiAliasedClipPaths(WTF::Vector<SkPath>& paths);
 
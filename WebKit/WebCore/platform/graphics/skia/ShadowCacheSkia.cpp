@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#include "config.h"
+#include "ShadowCacheSkia.h"
+
+#include "BoxBlurSkia.h"
+#include "FloatSize.h"
+
+#include "SkBlurMaskFilter.h"
+#include "SkCanvas.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+
+#include <math.h>
+#include <wtf/HashFunctions.h>
+#include <wtf/StdLibExtras.h>
+
+using namespace std;
+
+namespace WebCore {
+
+// Enough for a typical screen of shadowed tiles with a handful of different
+// corner radii and blurs.
+static const size_t defaultBudget = 2 * 1024 * 1024;
+
+// How far the blur of the draw looper reaches, see setPlatformShadow().
+static int blurExtent(float blur)
+{
+    if (boxBlurShadowsEnabled())
+        return boxBlurExtent(boxBlurWidth(blur / 2));
+
+    // SkBlurMaskFilter runs three box passes; one more pixel covers the
+    // partial weight of a fractional radius.
+    return 3 * static_cast<int>(ceilf(blur / 2)) + 1;
+}
+
+static bool isIntegral(SkScalar value)
+{
+    return SkScalarFraction(value) == 0;
+}
+
+ShadowCacheSkia& ShadowCacheSkia::shared()
+{
+    DEFINE_STATIC_LOCAL(ShadowCacheSkia, cache, ());
+    return cache;
+}
+
+ShadowCacheSkia::ShadowCacheSkia()
+    : m_entries(defaultBudget)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+unsigned ShadowCacheSkia::Key::hash() const
+{
+    unsigned hash = WTF::intHash(static_cast<uint32_t>(color));
+    hash = WTF::intHash(static_cast<uint64_t>(hash) << 32 | static_cast<uint32_t>(blur * 64));
+    for (unsigned i = 0; i < 8; ++i)
+        hash = WTF::intHash(static_cast<uint64_t>(hash) << 32 | static_cast<uint32_t>(radii[i]));
+    return hash;
+}
+
+bool ShadowCacheSkia::Key::operator==(const Key& other) const
+{
+    if (blur != other.blur || color != other.color)
+        return false;
+    for (unsigned i = 0; i < 8; ++i) {
+        if (radii[i] != other.radii[i])
+            return false;
+    }
+    return true;
+}
+
+bool ShadowCacheSkia::drawShadow(SkCanvas* canvas, const SkRect& rect, const IntSize* radii, const FloatSize& offset, float blur, SkColor color, const SkPaint& basePaint)
+{
+    if (!m_entries.budget() || blur <= 0 || !SkColorGetA(color))
+        return false;
+
+    if (!isIntegral(rect.fLeft) || !isIntegral(rect.fTop) || !isIntegral(rect.fRight) || !isIntegral(rect.fBottom))
+        return false;
+
+    Key key;
+    key.blur = blur;
+    key.color = color;
+    for (unsigned i = 0; i < 4; ++i) {
+        key.radii[2 * i] = radii ? radii[i].width() : 0;
+        key.radii[2 * i + 1] = radii ? radii[i].height() : 0;
+    }
+
+    // The template needs room for both corners plus the blur reaching in from
+    // either side around its center row and column.
+    int extent = blurExtent(blur);
+    int leftRadius = max(key.radii[0], key.radii[4]);
+    int rightRadius = max(key.radii[2], key.radii[6]);
+    int topRadius = max(key.radii[1], key.radii[3]);
+    int bottomRadius = max(key.radii[5], key.radii[7]);
+    int width = SkScalarRound(rect.width());
+    int height = SkScalarRound(rect.height());
+    if (width < leftRadius + rightRadius + 2 * extent + 1 || height < topRadius + bottomRadius + 2 * extent + 1)
+        return false;
+
+    Entry* entry = m_entries.find(key);
+    if (entry)
+        ++m_hits;
+    else {
+        ++m_misses;
+        entry = createEntry(key, extent);
+        if (!entry)
+            return false;
+    }
+
+    const SkBitmap& bitmap = entry->bitmap;
+    int sourceX[4] = { 0, entry->centerX, entry->centerX + 1, bitmap.width() };
+    int sourceY[4] = { 0, entry->centerY, entry->centerY + 1, bitmap.height() };
+
+    SkScalar left = rect.fLeft + SkFloatToScalar(offset.width()) - SkIntToScalar(extent);
+    SkScalar top = rect.fTop + SkFloatToScalar(offset.height()) - SkIntToScalar(extent);
+    SkScalar right = rect.fRight + SkFloatToScalar(offset.width()) + SkIntToScalar(extent);
+    SkScalar bottom = rect.fBottom + SkFloatToScalar(offset.height()) + SkIntToScalar(extent);
+    SkScalar destX[4] = { left, left + SkIntToScalar(sourceX[1]), right - SkIntToScalar(sourceX[3] - sourceX[2]), right };
+    SkScalar destY[4] = { top, top + SkIntToScalar(sourceY[1]), bottom - SkIntToScalar(sourceY[3] - sourceY[2]), bottom };
+
+    SkPaint paint;
+    paint.setXfermode(basePaint.getXfermode());
+    paint.setFilterBitmap(false);
+
+    for (unsigned row = 0; row < 3; ++row) {
+        for (unsigned column = 0; column < 3; ++column) {
+            SkIRect source;
+            source.set(sourceX[column], sourceY[row], sourceX[column + 1], sourceY[row + 1]);
+            SkRect dest;
+            dest.set(destX[column], destY[row], destX[column + 1], destY[row + 1]);
+            if (dest.isEmpty())
+                continue;
+            canvas->drawBitmapRect(bitmap, &source, dest, &paint);
+        }
+    }
+
+    return true;
+}
+
+ShadowCacheSkia::Entry* ShadowCacheSkia::createEntry(const Key& key, int extent)
+{
+    int leftRadius = max(key.radii[0], key.radii[4]);
+    int rightRadius = max(key.radii[2], key.radii[6]);
+    int topRadius = max(key.radii[1], key.radii[3]);
+    int bottomRadius = max(key.radii[5], key.radii[7]);
+
+    int shapeWidth = leftRadius + rightRadius + 2 * extent + 1;
+    int shapeHeight = topRadius + bottomRadius + 2 * extent + 1;
+
+    Entry* entry = new Entry;
+    entry->key = key;
+    entry->centerX = extent + leftRadius + extent;
+    entry->centerY = extent + topRadius + extent;
+
+    SkBitmap& bitmap = entry->bitmap;
+    bitmap.setConfig(SkBitmap::kARGB_8888_Config, shapeWidth + 2 * extent, shapeHeight + 2 * extent);
+    if (!bitmap.allocPixels()) {
+        delete entry;
+        return 0;
+    }
+    bitmap.eraseARGB(0, 0, 0, 0);
+
+    SkRect shape;
+    shape.set(SkIntToScalar(extent), SkIntToScalar(extent), SkIntToScalar(extent + shapeWidth), SkIntToScalar(extent + shapeHeight));
+
+    // SkPath orders the corners clockwise starting at the top left.
+    SkScalar radii[8] = {
+        SkIntToScalar(key.radii[0]), SkIntToScalar(key.radii[1]),
+        SkIntToScalar(key.radii[2]), SkIntToScalar(key.radii[3]),
+        SkIntToScalar(key.radii[6]), SkIntToScalar(key.radii[7]),
+        SkIntToScalar(key.radii[4]), SkIntToScalar(key.radii[5])
+    };
+    SkPath path;
+    path.addRoundRect(shape, radii);
+
+    // Same mask filter the draw looper would use for this blur.
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(key.color);
+    SkMaskFilter* blurFilter;
+    if (boxBlurShadowsEnabled())
+        blurFilter = createBoxBlurMaskFilter(SkFloatToScalar(key.blur / 2));
+    else
+        blurFilter = SkBlurMaskFilter::Create(SkFloatToScalar(key.blur / 2), SkBlurMaskFilter::kNormal_BlurStyle);
+    paint.setMaskFilter(blurFilter);
+    blurFilter->unref();
+
+    SkCanvas canvas(bitmap);
+    canvas.drawPath(path, paint);
+
+    entry->cost = bitmap.getSize();
+    m_entries.add(entry);
+
+    return entry;
+}
+
+} // namespace WebCore
+
+/* FYWEBKITMOD END */
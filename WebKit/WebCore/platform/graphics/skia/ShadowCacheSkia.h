@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* FYWEBKITMOD BEGIN */
+
+#ifndef ShadowCacheSkia_h
+#define ShadowCacheSkia_h
+
+#include "BudgetedLRUCacheFymp.h"
+#include "IntSize.h"
+
+#include "SkBitmap.h"
+#include "SkColor.h"
+
+#include <wtf/Noncopyable.h>
+
+class SkCanvas;
+class SkPaint;
+struct SkRect;
+
+namespace WebCore {
+
+class FloatSize;
+
+// Cache of pre-blurred shadow bitmaps for rects and rounded rects.
+//
+// SkBlurDrawLooper blurs the whole shape again on every draw. For box shadows
+// the blurred image only depends on the corner radii, the blur radius and the
+// color: everything between the corners is a straight copy of the middle row
+// or column. We therefore blur a minimal template of the shape once, keep it
+// as a nine-patch and draw later shadows of any larger size by stretching its
+// center row and column.
+//
+// Entries are evicted in least recently used order once their total size
+// exceeds budget().
+class ShadowCacheSkia : public Noncopyable {
+public:
+    static ShadowCacheSkia& shared();
+
+    // Draws the shadow the current draw looper would produce for |rect|, which
+    // must be in integral local coordinates. |radii| are the top left, top
+    // right, bottom left and bottom right corner radii, or 0 for a plain rect.
+    // |paint| supplies the transfer mode. Returns false without drawing if the
+    // shadow can't be built from a nine-patch; the caller then has to paint
+    // with the looper.
+    bool drawShadow(SkCanvas*, const SkRect&, const IntSize* radii, const FloatSize& offset, float blur, SkColor, const SkPaint&);
+
+    void setBudget(size_t bytes) { m_entries.setBudget(bytes); }
+    size_t budget() const { return m_entries.budget(); }
+    size_t size() const { return m_entries.size(); }
+
+    void clear() { m_entries.clear(); }
+
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    ShadowCacheSkia();
+
+    struct Key {
+        unsigned hash() const;
+        bool operator==(const Key&) const;
+        // Shadows without blur never go through the cache, so a zero blur
+        // marks the empty bucket and a negative one the deleted bucket.
+        bool isHashTableDeletedValue() const { return blur == -1; }
+        void setHashTableDeletedValue() { blur = -1; }
+
+        int radii[8];
+        float blur;
+        SkColor color;
+    };
+
+    struct Entry {
+        Key key;
+        size_t cost;
+        SkBitmap bitmap;
+        // Source offsets of the stretched center column and row.
+        int centerX;
+        int centerY;
+    };
+
+    Entry* createEntry(const Key&, int extent);
+
+    BudgetedLRUCacheFymp<Key, Entry> m_entries;
+
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+} // namespace WebCore
+
+#endif // ShadowCacheSkia_h
+
+/* FYWEBKITMOD END */
@@ -28,12 +28,131 @@
 #include "SkImageEncoder.h"
 #include "skia/ext/platform_canvas.h"
 
+#include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
+
 namespace WebCore {
 
+// Pixel buffers of destroyed textures, handed out again to textures of a similar
+// size. Layers that are resized or recreated during animations then don't go back
+// to the allocator every frame.
+class TexturePoolSkia {
+public:
+    static TexturePoolSkia& shared()
+    {
+        DEFINE_STATIC_LOCAL(TexturePoolSkia, pool, ());
+        return pool;
+    }
+
+    TexturePoolSkia()
+        : m_limit(4 * 1024 * 1024)
+        , m_allocatedBytes(0)
+        , m_pooledBytes(0)
+        , m_hits(0)
+        , m_misses(0)
+    {
+    }
+
+    bool acquire(SkBitmap&, const IntSize&);
+    void release(SkBitmap&);
+    void setLimit(size_t bytes);
+    void getStatistics(TextureMapperMemoryStatistics&) const;
+
+private:
+    void shrinkTo(size_t bytes);
+
+    Vector<SkBitmap> m_bitmaps; // oldest first
+    size_t m_limit;
+    size_t m_allocatedBytes;
+    size_t m_pooledBytes;
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+// Takes the smallest pooled buffer that fits |size| without wasting more than its
+// own area, or allocates a new one.
+bool TexturePoolSkia::acquire(SkBitmap& bitmap, const IntSize& size)
+{
+    const size_t area = static_cast<size_t>(size.width()) * size.height();
+    int best = -1;
+    for (size_t i = 0; i < m_bitmaps.size(); ++i) {
+        const SkBitmap& candidate = m_bitmaps[i];
+        const size_t candidateArea = static_cast<size_t>(candidate.width()) * candidate.height();
+        if (candidate.width() < size.width() || candidate.height() < size.height() || candidateArea > 2 * area)
+            continue;
+        if (best < 0 || candidateArea < static_cast<size_t>(m_bitmaps[best].width()) * m_bitmaps[best].height())
+            best = i;
+    }
+
+    if (best >= 0) {
+        ++m_hits;
+        bitmap = m_bitmaps[best];
+        m_bitmaps.remove(best);
+        m_pooledBytes -= bitmap.getSize();
+    } else {
+        ++m_misses;
+        bitmap.setConfig(SkBitmap::kARGB_8888_Config, size.width(), size.height());
+        if (!bitmap.allocPixels()) {
+            // Give the allocator everything we hold and try once more.
+            shrinkTo(0);
+            if (!bitmap.allocPixels()) {
+                bitmap = SkBitmap();
+                return false;
+            }
+        }
+    }
+    m_allocatedBytes += bitmap.getSize();
+    return true;
+}
+
+void TexturePoolSkia::release(SkBitmap& bitmap)
+{
+    const size_t bytes = bitmap.getSize();
+    m_allocatedBytes -= bytes;
+    if (bytes <= m_limit) {
+        shrinkTo(m_limit - bytes);
+        m_bitmaps.append(bitmap);
+        m_pooledBytes += bytes;
+    }
+    bitmap = SkBitmap();
+}
+
+void TexturePoolSkia::shrinkTo(size_t bytes)
+{
+    while (m_pooledBytes > bytes && !m_bitmaps.isEmpty()) {
+        m_pooledBytes -= m_bitmaps[0].getSize();
+        m_bitmaps.remove(0);
+    }
+}
+
+void TexturePoolSkia::setLimit(size_t bytes)
+{
+    m_limit = bytes;
+    shrinkTo(bytes);
+}
+
+void TexturePoolSkia::getStatistics(TextureMapperMemoryStatistics& statistics) const
+{
+    statistics.allocatedBytes = m_allocatedBytes;
+    statistics.pooledBytes = m_pooledBytes;
+    statistics.poolHits = m_hits;
+    statistics.poolMisses = m_misses;
+}
+
+void setTexturePoolLimit(size_t bytes)
+{
+    TexturePoolSkia::shared().setLimit(bytes);
+}
+
+void getTexturePoolStatistics(TextureMapperMemoryStatistics& statistics)
+{
+    TexturePoolSkia::shared().getStatistics(statistics);
+}
+
 class BitmapTextureSkia : public BitmapTexture {
     friend class TextureMapperSkia;
 public:
-    BitmapTextureSkia() : m_context(0), m_device(0), m_gc(0) { }
+    BitmapTextureSkia() : m_context(0), m_device(0), m_gc(0), m_ownsPixels(false) { }
     ~BitmapTextureSkia() { destroy(); }
     virtual void destroy();
     virtual IntSize size() const { return IntSize(m_bitmap.width(), m_bitmap.height()); }
@@ -47,11 +166,13 @@ public:
     IntRect sourceRect() const { return IntRect(0, 0, contentSize().width(), contentSize().height()); }
 private:
     void clearBitmap(const IntRect *rect=0);
+    void releaseBitmap();
     SkBitmap               m_bitmap;
     skia::PlatformCanvas   m_canvas;
     PlatformContextSkia    m_context;
     skia::PlatformDevice  *m_device;
     GraphicsContext       *m_gc;
+    bool                   m_ownsPixels; // false for the pixels of an image, see setContentsToImage()
 };
 
 class TextureMapperSkia : public TextureMapper {
@@ -64,40 +185,48 @@ public:
     TextureMapperSkia(GraphicsContext* gc);
     virtual const char* type() const { return "Skia"; }
     virtual PassRefPtr<BitmapTexture> createTexture();
+    virtual PlatformGraphicsContext* beginDirectPaint(const IntRect& targetRect, const TransformationMatrix&, float opacity);
+    virtual void endDirectPaint();
 
 private:
     PlatformContextSkia       *m_context;
     SkRect                     m_clipRect;
     RefPtr<BitmapTextureSkia>  m_currentSurface;
+    PlatformContextSkia       *m_directPaintContext;
+    int                        m_directPaintSaveCount;
 };
 
 void BitmapTextureSkia::destroy()
 {
     m_context.setCanvas(0);
+    // The canvas holds the only reference to the device, see reset().
     m_canvas.setDevice(0);
-#if 0
-    fprintf(stderr, "Destroy[%p/%p]!\n", this, m_device); fflush(stderr);
-    if(m_device)
-        m_device->unref();
-#endif
     m_device = 0;
+    releaseBitmap();
+}
+
+void BitmapTextureSkia::releaseBitmap()
+{
+    if (m_ownsPixels && !m_bitmap.empty())
+        TexturePoolSkia::shared().release(m_bitmap);
     m_bitmap = SkBitmap();
+    m_ownsPixels = false;
 }
 
 void BitmapTextureSkia::reset(const IntSize& size, bool isOpaque)
 {
     BitmapTexture::reset(size, isOpaque);
-    if (size.width() > m_bitmap.width() || size.height() > m_bitmap.height() || m_bitmap.empty()) {
-        m_bitmap.setConfig(SkBitmap::kARGB_8888_Config, size.width(), size.height());
-        m_bitmap.allocPixels();
-#if 0
-        fprintf(stderr, "Reset1[%p/%p]!\n", this, m_device); fflush(stderr);
-        if(m_device)
-            m_device->unref();
-#endif
+    if (size.width() > m_bitmap.width() || size.height() > m_bitmap.height() || m_bitmap.empty() || !m_ownsPixels) {
+        m_canvas.setDevice(0);
+        m_device = 0;
+        releaseBitmap();
+        if (!TexturePoolSkia::shared().acquire(m_bitmap, size))
+            return;
+        m_ownsPixels = true;
         m_device = new skia::PlatformDevice(m_bitmap);
-        //fprintf(stderr, "Reset2[%p/%p]!\n", this, m_device); fflush(stderr);
-        m_canvas.setDevice(m_device);
+        // Hand our reference over to the canvas; the device and with it the pixels go
+        // away as soon as the canvas lets go of it.
+        m_canvas.setDevice(m_device)->unref();
     }
     m_bitmap.setIsOpaque(isOpaque);
     clearBitmap();
@@ -142,6 +271,7 @@ void BitmapTextureSkia::setContentsToImage(Image* image)
     BitmapTexture::reset(IntSize(bitmap->width(), bitmap->height()), bitmap->isOpaque());
     destroy();
     m_bitmap = SkBitmap(*bitmap);
+    m_ownsPixels = false;
 }
 
 void TextureMapperSkia::setClip(const IntRect& rect)
@@ -151,7 +281,9 @@ void TextureMapperSkia::setClip(const IntRect& rect)
 
 TextureMapperSkia::TextureMapperSkia(GraphicsContext* gc) : TextureMapper(gc),
                                                             m_currentSurface(0),
-                                                            m_context(gc->platformContext())
+                                                            m_context(gc->platformContext()),
+                                                            m_directPaintContext(0),
+                                                            m_directPaintSaveCount(0)
 {
 }
 
@@ -230,6 +362,35 @@ void TextureMapperSkia::drawTexture(const BitmapTexture& aTexture, const IntRect
     }
 }
 
+PlatformGraphicsContext* TextureMapperSkia::beginDirectPaint(const IntRect& targetRect, const TransformationMatrix& matrix, float opacity)
+{
+    PlatformContextSkia* context = m_currentSurface ? &m_currentSurface->m_context : m_context;
+    skia::PlatformCanvas* canvas = context->canvas();
+    if (!canvas)
+        return 0;
+
+    // Same clip and transform drawTexture() would use for the layer's texture.
+    m_directPaintContext = context;
+    m_directPaintSaveCount = canvas->save();
+    canvas->clipRect(m_clipRect, SkRegion::kReplace_Op);
+    canvas->setMatrix(matrix);
+    SkRect rect = targetRect;
+    canvas->clipRect(rect, SkRegion::kIntersect_Op);
+    if (opacity < 1) {
+        int alpha = opacity * 255;
+        canvas->saveLayerAlpha(&rect, alpha < 0 ? 0 : alpha);
+    }
+    return context;
+}
+
+void TextureMapperSkia::endDirectPaint()
+{
+    if (!m_directPaintContext)
+        return;
+    m_directPaintContext->canvas()->restoreToCount(m_directPaintSaveCount);
+    m_directPaintContext = 0;
+}
+
 PassRefPtr<TextureMapper> TextureMapper::create(GraphicsContext* gc)
 {
     return adoptRef(new TextureMapperSkia(gc));
@@ -35,6 +35,7 @@
 #include "TransformOperations.h"
 #include "TranslateTransformOperation.h"
 #include "UnitBezier.h"
+#include <algorithm>
 #include <stdio.h>
 
 #if PLATFORM(QT)
@@ -147,6 +148,28 @@ void TextureMapperCache::mark(BitmapTexture *texture)
 
 TextureMapperCache gTextureMapperCache;
 
+// Budget for the pixels of all layer textures, see setCompositingMemoryBudget().
+static size_t gCompositingMemoryBudget = 0;
+static unsigned gLayersWithContent = 0;
+static unsigned gDemotedLayers = 0;
+
+// Layers whose transform, opacity or position changed within this many seconds count
+// as animated and are the last to lose their texture.
+static const double recentMotionInterval = 1.0;
+
+void setCompositingMemoryBudget(size_t bytes)
+{
+    gCompositingMemoryBudget = bytes;
+}
+
+void getCompositingMemoryStatistics(TextureMapperMemoryStatistics& statistics)
+{
+    getTexturePoolStatistics(statistics);
+    statistics.budget = gCompositingMemoryBudget;
+    statistics.layers = gLayersWithContent;
+    statistics.demotedLayers = gDemotedLayers;
+}
+
 class TextureMapperCacheLock {
 public:
     TextureMapperCacheLock(BitmapTexture* texture) : m_texture(texture)
@@ -242,8 +265,15 @@ public:
 
     void paintRecursive(TexmapPaintOptions options);
     void paintSelf(TextureMapper* textureMapper, float opacity, BitmapTexture* maskTexture, BitmapTexture* replicaMaskTexture, bool isSurface);
+    bool paintSelfDirectly(TextureMapper* textureMapper, float opacity);
     void uploadTextureFromContent(TextureMapper* textureMapper);
 
+    bool canBeDemoted() const;
+    bool hasMovedRecently(double now) const { return m_anim.transformAnimationRunning || m_anim.opacityAnimationRunning || now - m_lastMotionTime < recentMotionInterval; }
+    size_t textureCost() const { return m_texture && m_texture->isValid() ? static_cast<size_t>(m_texture->size().width()) * m_texture->size().height() * 4 : 0; }
+    void collectLayersWithContent(Vector<TextureMapperNode*>&);
+    void enforceMemoryBudget();
+
     int countDescendantsWithContent() const;
     bool hasSurfaceDescendants() const;
 
@@ -329,6 +359,9 @@ public:
 
     RefPtr<BitmapTexture> m_texture;
     RefPtr<BitmapTexture> m_surface, m_replicaSurface;
+    // Painted straight into the target without m_texture, to stay within the memory budget.
+    bool m_demoted;
+    double m_lastMotionTime;
 
     ContentData m_pendingContent;
     ContentData m_currentContent;
@@ -489,6 +522,7 @@ void TextureMapperNode::paint(GraphicsContext* gc, const IntSize& size, const In
         textureMapper->bindSurface(0);
         textureMapper->paintToTarget(*m_surface.get(), size, transform, opacity * m_state.opacity, targetRect);
     }
+    enforceMemoryBudget();
     gTextureMapperCache.purge();
 #if 0
     {
@@ -607,6 +641,8 @@ TextureMapperNode::TextureMapperNode(GraphicsLayerTextureMapper* newLayer)
     , m_notifyAnimationStartedTimer(this, &TextureMapperNode::notifyAnimationStartedTimerFired)
 #endif
     , m_surface(0)
+    , m_demoted(false)
+    , m_lastMotionTime(0)
     , m_parent(0)
     , m_effectTarget(0)
     , m_changeMask(NoChanges)
@@ -774,6 +810,9 @@ void TextureMapperNode::uploadTextureFromContent(TextureMapper* textureMapper)
         return;
     }
 
+    if (m_demoted && m_currentContent.contentType == HTMLContentType)
+        return;
+
     if (m_currentContent.contentType == DirectImageContentType) {
         if (m_currentContent.image)
             m_texture->setContentsToImage(m_currentContent.image.get());
@@ -831,6 +870,8 @@ void TextureMapperNode::paintSelf(TextureMapper* textureMapper, float opacity, B
     // needs active context
     if (!m_layer || m_size.isEmpty() || (!m_state.drawsContent && m_currentContent.contentType == HTMLContentType))
         return;
+    if (m_demoted && paintSelfDirectly(textureMapper, opacity))
+        return;
     uploadTextureFromContent(textureMapper);
     if (m_state.replicaLayer && !isSurface)
         textureMapper->drawTexture(*m_texture.get(), replicaRect(), m_transforms.replica,
@@ -843,6 +884,116 @@ void TextureMapperNode::paintSelf(TextureMapper* textureMapper, float opacity, B
     textureMapper->drawTexture(*m_texture.get(), rect, transform, opacity, isSurface ? 0 : maskTexture);
 }
 
+bool TextureMapperNode::paintSelfDirectly(TextureMapper* textureMapper, float opacity)
+{
+    // needs active context
+    const IntRect rect = m_layerType == ClipLayer ? fullRect() : targetRect();
+    const TransformationMatrix transform = m_layerType == ClipLayer ? TransformationMatrix() : m_transforms.target;
+    PlatformGraphicsContext* pgc = canBeDemoted() ? textureMapper->beginDirectPaint(rect, transform, opacity) : 0;
+    if (!pgc) {
+        // Back to a texture; enforceMemoryBudget() picks another layer if needed.
+        m_demoted = false;
+        return false;
+    }
+
+    {
+        GraphicsContext gc(pgc);
+        if (GraphicsContext* originalGC = textureMapper->graphicsContext()) {
+            gc.setImageInterpolationQuality(originalGC->imageInterpolationQuality());
+            gc.setTextDrawingMode(originalGC->textDrawingMode());
+        }
+        m_layer->paintGraphicsLayerContents(gc, rect);
+    }
+    textureMapper->endDirectPaint();
+
+    m_currentContent.needsDisplayRect = IntRect();
+    m_currentContent.needsDisplay = false;
+    return true;
+}
+
+// Only plain content layers can do without a texture: masks, replicas and layers that
+// use them need the texture as a source.
+bool TextureMapperNode::canBeDemoted() const
+{
+    return m_layer && m_layerType != RootLayer && m_state.drawsContent && m_currentContent.contentType == HTMLContentType
+        && !m_state.maskLayer && !m_state.replicaLayer && !m_effectTarget;
+}
+
+void TextureMapperNode::collectLayersWithContent(Vector<TextureMapperNode*>& layers)
+{
+    if (canBeDemoted())
+        layers.append(this);
+    else
+        m_demoted = false;
+
+    const int size = m_children.size();
+    for (int i = 0; i < size; ++i)
+        if (TextureMapperNode* child = m_children[i])
+            child->collectLayersWithContent(layers);
+}
+
+// Orders layers by how much they gain from keeping their texture: layers that moved
+// recently come last, among the others larger ones first.
+class LessUsefulLayer {
+public:
+    LessUsefulLayer(double now) : m_now(now) { }
+    bool operator()(const TextureMapperNode* a, const TextureMapperNode* b) const
+    {
+        const bool aMoved = a->hasMovedRecently(m_now);
+        const bool bMoved = b->hasMovedRecently(m_now);
+        if (aMoved != bMoved)
+            return !aMoved;
+        return a->size().width() * a->size().height() > b->size().width() * b->size().height();
+    }
+private:
+    double m_now;
+};
+
+void TextureMapperNode::enforceMemoryBudget()
+{
+    // needs active context: texture.destroy
+    Vector<TextureMapperNode*> layers;
+    collectLayersWithContent(layers);
+    gLayersWithContent = layers.size();
+
+    const size_t budget = gCompositingMemoryBudget;
+    TextureMapperMemoryStatistics statistics;
+    getTexturePoolStatistics(statistics);
+    size_t allocated = statistics.allocatedBytes;
+
+    std::sort(layers.begin(), layers.end(), LessUsefulLayer(WTF::currentTime()));
+
+    if (budget && allocated > budget) {
+        for (size_t i = 0; i < layers.size() && allocated > budget; ++i) {
+            TextureMapperNode* layer = layers[i];
+            const size_t cost = layer->textureCost();
+            if (layer->m_demoted || !cost)
+                continue;
+            layer->m_demoted = true;
+            layer->m_texture->destroy();
+            allocated -= cost;
+        }
+    } else {
+        // Give textures back to the most useful layers first. A quarter of the budget
+        // stays free so that layers don't flip between both states every frame.
+        for (size_t i = layers.size(); i > 0; --i) {
+            TextureMapperNode* layer = layers[i - 1];
+            if (!layer->m_demoted)
+                continue;
+            const size_t cost = static_cast<size_t>(layer->size().width()) * layer->size().height() * 4;
+            if (budget && allocated + cost > budget / 4 * 3)
+                break;
+            layer->m_demoted = false;
+            allocated += cost;
+        }
+    }
+
+    gDemotedLayers = 0;
+    for (size_t i = 0; i < layers.size(); ++i)
+        if (layers[i]->m_demoted)
+            ++gDemotedLayers;
+}
+
 void TextureMapperNode::paintRecursive(TexmapPaintOptions options)
 {
     // needs active context
@@ -1106,6 +1257,8 @@ void TextureMapperNode::setTransformFromAnimationFrame(const TransformationMatri
 void TextureMapperNode::notifyChange(ChangeMask changeMask)
 {
     m_changeMask |= changeMask;
+    if (changeMask & (TransformChange | OpacityChange | PositionChange))
+        m_lastMotionTime = WTF::currentTime();
     if (!m_layer->client())
         return;
     m_layer->client()->notifySyncRequired(m_layer);
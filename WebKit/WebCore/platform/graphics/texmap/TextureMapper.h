@@ -131,6 +131,11 @@ public:
     virtual const char* type() const = 0;
     virtual void cleanup() {}
 
+    // Paints straight into the current surface for layers that don't keep a texture,
+    // see setCompositingMemoryBudget(). Returns 0 if the implementation can't.
+    virtual PlatformGraphicsContext* beginDirectPaint(const IntRect& targetRect, const TransformationMatrix&, float opacity) { return 0; }
+    virtual void endDirectPaint() {}
+
     GraphicsContext* graphicsContext() const { return m_gc; }
 
 protected:
@@ -138,6 +143,38 @@ protected:
     GraphicsContext* m_gc;
 };
 
+struct TextureMapperMemoryStatistics {
+    TextureMapperMemoryStatistics()
+        : budget(0)
+        , allocatedBytes(0)
+        , pooledBytes(0)
+        , poolHits(0)
+        , poolMisses(0)
+        , layers(0)
+        , demotedLayers(0)
+    {
+    }
+
+    size_t budget;
+    size_t allocatedBytes; // pixels owned by live textures
+    size_t pooledBytes; // released texture buffers kept for reuse
+    unsigned poolHits;
+    unsigned poolMisses;
+    unsigned layers; // layers with content of their own
+    unsigned demotedLayers; // of those, painted without a texture
+};
+
+// Limits the pixels held by layer textures. Once over budget, the largest layers that
+// haven't moved recently give up their textures and are painted directly into their
+// target on every composite, until there is room again. 0 means unlimited.
+void setCompositingMemoryBudget(size_t bytes);
+void getCompositingMemoryStatistics(TextureMapperMemoryStatistics&);
+
+// Implemented by the platform texture mapper: released texture buffers are kept in a
+// pool of this many bytes for textures of a similar size.
+void setTexturePoolLimit(size_t bytes);
+void getTexturePoolStatistics(TextureMapperMemoryStatistics&);
+
 };
 
 #endif
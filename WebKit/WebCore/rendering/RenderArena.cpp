@@ -37,9 +37,11 @@
 #include "config.h"
 #include "RenderArena.h"
 
+#include <algorithm>
 #include <stdlib.h>
 #include <string.h>
 #include <wtf/Assertions.h>
+#include <wtf/Vector.h>
 
 #define ROUNDUP(x, y) ((((x)+((y)-1))/(y))*(y))
 
@@ -73,6 +75,13 @@ RenderArena::RenderArena(unsigned arenaSize)
 
     // Zero out the recyclers array
     memset(m_recyclers, 0, sizeof(m_recyclers));
+
+/* FYWEBKITMOD BEGIN */
+    m_liveBytes = 0;
+    m_liveObjects = 0;
+    m_recycledBytes = 0;
+    m_inBulkTeardown = false;
+/* FYWEBKITMOD END */
 }
 
 RenderArena::~RenderArena()
@@ -96,6 +105,10 @@ void* RenderArena::allocate(size_t size)
     header->arena = this;
     header->size = size;
     header->signature = signature;
+/* FYWEBKITMOD BEGIN */
+    m_liveBytes += size;
+    ++m_liveObjects;
+/* FYWEBKITMOD END */
     return static_cast<char*>(block) + debugHeaderSize;
 #else
     void* result = 0;
@@ -112,6 +125,7 @@ void* RenderArena::allocate(size_t size)
             // Need to move to the next object
             void* next = *((void**)result);
             m_recyclers[index] = next;
+            m_recycledBytes -= size; // FYWEBKITMOD
         }
     }
 
@@ -120,6 +134,10 @@ void* RenderArena::allocate(size_t size)
         ARENA_ALLOCATE(result, &m_pool, size);
     }
 
+/* FYWEBKITMOD BEGIN */
+    m_liveBytes += size;
+    ++m_liveObjects;
+/* FYWEBKITMOD END */
     return result;
 #endif
 }
@@ -134,6 +152,10 @@ void RenderArena::free(size_t size, void* ptr)
     ASSERT_UNUSED(size, header->size == size);
     ASSERT(header->arena == this);
     header->signature = signatureDead;
+/* FYWEBKITMOD BEGIN */
+    m_liveBytes -= size;
+    --m_liveObjects;
+/* FYWEBKITMOD END */
 /* FYWEBKITMOD BEGIN */
 #if PLATFORM(FYMP) && !PLATFORM(FYMP_VS) // FYWEBKITMOD excluded VisualStudio build
 	FYMPwebkitGlue::RAfree(block);
@@ -145,14 +167,129 @@ void RenderArena::free(size_t size, void* ptr)
     // Ensure we have correct alignment for pointers.  Important for Tru64
     size = ROUNDUP(size, sizeof(void*));
 
+/* FYWEBKITMOD BEGIN */
+    m_liveBytes -= size;
+    --m_liveObjects;
+
+    // The whole pool is released right after the teardown, recycling is pointless.
+    if (m_inBulkTeardown)
+        return;
+/* FYWEBKITMOD END */
+
     // See if it's a size that we recycle
     if (size < gMaxRecycledSize) {
         const int index = size >> 2;
         void* currentTop = m_recyclers[index];
         m_recyclers[index] = ptr;
         *((void**)ptr) = currentTop;
+        m_recycledBytes += size; // FYWEBKITMOD
     }
 #endif
 }
 
+/* FYWEBKITMOD BEGIN */
+#ifdef NDEBUG
+static size_t arenaIndexForPointer(const Vector<Arena*>& arenas, void* ptr)
+{
+    // arenas is sorted by address, find the last one starting at or before ptr.
+    size_t low = 0;
+    size_t high = arenas.size();
+    while (high - low > 1) {
+        size_t middle = (low + high) / 2;
+        if (reinterpret_cast<uword>(arenas[middle]) <= reinterpret_cast<uword>(ptr))
+            low = middle;
+        else
+            high = middle;
+    }
+    ASSERT(reinterpret_cast<uword>(ptr) >= arenas[low]->base && reinterpret_cast<uword>(ptr) < arenas[low]->avail);
+    return low;
+}
+#endif
+
+size_t RenderArena::releaseFreeArenas()
+{
+#ifndef NDEBUG
+    // Debug builds do not allocate from the pool.
+    return 0;
+#else
+    if (!m_recycledBytes)
+        return 0;
+
+    Vector<Arena*> arenas;
+    for (Arena* a = m_pool.first.next; a; a = a->next)
+        arenas.append(a);
+    if (arenas.isEmpty())
+        return 0;
+    std::sort(arenas.begin(), arenas.end());
+
+    // Sum up the recycled bytes per arena.
+    Vector<size_t> recycledInArena(arenas.size());
+    recycledInArena.fill(0);
+    for (size_t index = 0; index < (gMaxRecycledSize >> 2); ++index) {
+        for (void* block = m_recyclers[index]; block; block = *static_cast<void**>(block))
+            recycledInArena[arenaIndexForPointer(arenas, block)] += index << 2;
+    }
+
+    Vector<bool> releasable(arenas.size());
+    bool anyReleasable = false;
+    for (size_t i = 0; i < arenas.size(); ++i) {
+        releasable[i] = recycledInArena[i] == arenas[i]->avail - arenas[i]->base;
+        anyReleasable |= releasable[i];
+    }
+    if (!anyReleasable)
+        return 0;
+
+    // Unlink the recycled blocks that live in the arenas about to go away.
+    for (size_t index = 0; index < (gMaxRecycledSize >> 2); ++index) {
+        void** link = &m_recyclers[index];
+        while (*link) {
+            if (releasable[arenaIndexForPointer(arenas, *link)]) {
+                *link = *static_cast<void**>(*link);
+                m_recycledBytes -= index << 2;
+            } else
+                link = static_cast<void**>(*link);
+        }
+    }
+
+    size_t releasedBytes = 0;
+    Arena* previous = &m_pool.first;
+    for (Arena* a = previous->next; a; a = previous->next) {
+        size_t i = std::lower_bound(arenas.begin(), arenas.end(), a) - arenas.begin();
+        if (releasable[i]) {
+            previous->next = a->next;
+            releasedBytes += a->limit - reinterpret_cast<uword>(a);
+            fastFree(a);
+        } else
+            previous = a;
+    }
+    // ArenaAllocate() walks the pool from here looking for space.
+    m_pool.current = &m_pool.first;
+
+    return releasedBytes;
+#endif
+}
+
+RenderArena::Statistics RenderArena::statistics() const
+{
+    Statistics statistics;
+    statistics.committedBytes = 0;
+    statistics.usedBytes = 0;
+    statistics.arenaCount = 0;
+    for (const Arena* a = m_pool.first.next; a; a = a->next) {
+        statistics.committedBytes += a->limit - reinterpret_cast<uword>(a);
+        statistics.usedBytes += a->avail - a->base;
+        ++statistics.arenaCount;
+    }
+#ifndef NDEBUG
+    // Debug builds malloc every object, account them as committed.
+    statistics.committedBytes += m_liveBytes + m_liveObjects * debugHeaderSize;
+    statistics.usedBytes += m_liveBytes;
+#endif
+    statistics.liveBytes = m_liveBytes;
+    statistics.liveObjects = m_liveObjects;
+    statistics.recycledBytes = m_recycledBytes;
+    return statistics;
+}
+/* FYWEBKITMOD END */
+
 } // namespace WebCore
@@ -56,6 +56,44 @@ public:
     void* allocate(size_t);
     void free(size_t, void*);
 
+/* FYWEBKITMOD BEGIN */
+    // Called by Document::detach() right before the render tree is destroyed.
+    // From then on freed blocks are not recycled anymore. Only InlineTextBox
+    // skips its individual destruction (see RenderText::deleteTextBoxes()):
+    // flow and root line boxes own overflow rects, float lists and bidi
+    // contexts outside the arena, and renderers unregister themselves from
+    // the document and their layers, so all of these still go one by one.
+    void beginBulkTeardown() { m_inBulkTeardown = true; }
+    bool canSkipFree() const
+    {
+#ifndef NDEBUG
+        // Debug builds malloc every object, skipping the free would leak.
+        return false;
+#else
+        return m_inBulkTeardown;
+#endif
+    }
+
+    // Returns arenas whose objects have all been freed (i.e. sit in the
+    // recyclers) to the system. Used when a document moves into the page cache.
+    size_t releaseFreeArenas();
+
+    struct Statistics {
+        size_t committedBytes;  // arenas allocated from the system
+        size_t usedBytes;       // handed out from the arenas at some point
+        size_t liveBytes;       // currently allocated objects
+        size_t recycledBytes;   // freed objects waiting in the recyclers
+        size_t liveObjects;
+        size_t arenaCount;
+
+        // Bytes of committed memory not backing a live object.
+        size_t wastedBytes() const { return committedBytes - liveBytes; }
+        // Percentage of the used arena space that is sitting in the recyclers.
+        unsigned fragmentationPercent() const { return usedBytes ? static_cast<unsigned>(recycledBytes * 100 / usedBytes) : 0; }
+    };
+    Statistics statistics() const;
+/* FYWEBKITMOD END */
+
 private:
 	RenderArena(unsigned arenaSize = 4096); //FYWEBKITMOD: Declared it 'private'. According to r149185 when integrating patch for CVE-2013-2842.
     // Underlying arena pool
@@ -64,6 +102,13 @@ private:
     // The recycler array is sparse with the indices being multiples of 4,
     // i.e., 0, 4, 8, 12, 16, 20, ...
     void* m_recyclers[gMaxRecycledSize >> 2];
+
+/* FYWEBKITMOD BEGIN */
+    size_t m_liveBytes;
+    size_t m_liveObjects;
+    size_t m_recycledBytes;
+    bool m_inBulkTeardown;
+/* FYWEBKITMOD END */
 };
 
 } // namespace WebCore
@@ -634,6 +634,46 @@ void RenderBox::paintBoxDecorations(PaintInfo& paintInfo, int tx, int ty)
     return paintBoxDecorationsWithSize(paintInfo, tx, ty, width(), height());
 }
 
+/* FYWEBKITMOD BEGIN */
+bool RenderBox::backgroundIsKnownToBeOpaque() const
+{
+    const RenderStyle* style = this->style();
+    if (style->visibility() != VISIBLE || style->hasBorderRadius() || style->hasAppearance() || style->borderFit() == BorderFitLines)
+        return false;
+
+    // The root paints the canvas background instead, and the body may hand its
+    // background on to the root.
+    if (isRoot() || isBody())
+        return false;
+
+    // Fill layers are listed top to bottom; the color is painted under the last
+    // one. Other composite operators may punch holes into lower layers.
+    const FillLayer* lastLayer = style->backgroundLayers();
+    for (; ; lastLayer = lastLayer->next()) {
+        if (lastLayer->composite() != CompositeSourceOver)
+            return false;
+        if (!lastLayer->next())
+            break;
+    }
+    Color color = style->visitedDependentColor(CSSPropertyBackgroundColor);
+    if (lastLayer->clip() == BorderFillBox && color.isValid() && !color.hasAlpha())
+        return true;
+
+    // An opaque image repeated in both directions covers its clip box entirely.
+    for (const FillLayer* layer = style->backgroundLayers(); layer; layer = layer->next()) {
+        StyleImage* styleImage = layer->image();
+        if (!styleImage || layer->clip() != BorderFillBox || layer->repeatX() != RepeatFill || layer->repeatY() != RepeatFill)
+            continue;
+        if (!styleImage->isLoaded() || styleImage->errorOccurred() || !styleImage->canRender(style->effectiveZoom()))
+            continue;
+        Image* image = styleImage->image(const_cast<RenderBox*>(this), IntSize(width(), height()));
+        if (image && !image->isNull() && image->currentFrameKnownToBeOpaque())
+            return true;
+    }
+    return false;
+}
+/* FYWEBKITMOD END */
+
 void RenderBox::paintBoxDecorationsWithSize(PaintInfo& paintInfo, int tx, int ty, int width, int height)
 {
     // border-fit can adjust where we paint our border and background.  If set, we snugly fit our line box descendants.  (The iChat
@@ -269,6 +269,11 @@ public:
 
     virtual void paintObject(PaintInfo&, int /*tx*/, int /*ty*/) { ASSERT_NOT_REACHED(); }
     virtual void paintBoxDecorations(PaintInfo&, int tx, int ty);
+/* FYWEBKITMOD BEGIN */
+    // True if paintBoxDecorations() is known to cover the whole border box
+    // with opaque pixels.
+    bool backgroundIsKnownToBeOpaque() const;
+/* FYWEBKITMOD END */
     virtual void paintMask(PaintInfo&, int tx, int ty);
     virtual void imageChanged(WrappedImagePtr, const IntRect* = 0);
 
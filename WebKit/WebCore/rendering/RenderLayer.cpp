@@ -80,6 +80,7 @@
 #include "RenderTreeAsText.h"
 #include "RenderView.h"
 #include "ScaleTransformOperation.h"
+#include "Settings.h" // FYWEBKITMOD
 #include "Scrollbar.h"
 #include "ScrollbarTheme.h"
 #include "SelectionController.h"
@@ -1337,6 +1338,7 @@ void RenderLayer::scrollToOffset(int x, int y, bool updateScrollbars, bool repai
         return;
     m_scrollX = newScrollX;
     m_scrollY = y;
+    renderer()->document()->didScrollLayer(); // FYWEBKITMOD
 
     // Update the positions of our child layers. Don't have updateLayerPositions() update
     // compositing layers, because we need to do a deep update from the compositing ancestor.
@@ -2436,9 +2438,18 @@ void RenderLayer::paintLayer(RenderLayer* rootLayer, GraphicsContext* p,
     if (overlapTestRequests)
         performOverlapTests(*overlapTestRequests, layerBounds);
 
+/* FYWEBKITMOD BEGIN */
+    // Skip everything a positive z-order child hides completely, e.g. a full
+    // screen background image under an opaque panel.
+    size_t firstPosZOrderChild = occludingPosZOrderChild(rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, localPaintFlags);
+    bool occluded = firstPosZOrderChild != notFound;
+    if (!occluded)
+        firstPosZOrderChild = 0;
+/* FYWEBKITMOD END */
+
     // We want to paint our layer, but only if we intersect the damage rect.
     bool shouldPaint = intersectsDamageRect(layerBounds, damageRect, rootLayer) && m_hasVisibleContent && isSelfPaintingLayer();
-    if (shouldPaint && !selectionOnly && !damageRect.isEmpty()) {
+    if (shouldPaint && !selectionOnly && !damageRect.isEmpty() && !occluded) { // FYWEBKITMOD: !occluded
         // Begin transparency layers lazily now that we know we have to paint something.
         if (haveTransparency)
             beginTransparencyLayers(p, rootLayer, paintBehavior);
@@ -2456,10 +2467,11 @@ void RenderLayer::paintLayer(RenderLayer* rootLayer, GraphicsContext* p,
     }
 
     // Now walk the sorted list of children with negative z-indices.
-    paintList(m_negZOrderList, rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, localPaintFlags);
+    if (!occluded) // FYWEBKITMOD
+        paintList(m_negZOrderList, rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, localPaintFlags);
 
     // Now establish the appropriate clip and paint our child RenderObjects.
-    if (shouldPaint && !clipRectToApply.isEmpty()) {
+    if (shouldPaint && !clipRectToApply.isEmpty() && !occluded) { // FYWEBKITMOD: !occluded
         // Begin transparency layers lazily now that we know we have to paint something.
         if (haveTransparency)
             beginTransparencyLayers(p, rootLayer, paintBehavior);
@@ -2484,7 +2496,7 @@ void RenderLayer::paintLayer(RenderLayer* rootLayer, GraphicsContext* p,
         restoreClip(p, paintDirtyRect, clipRectToApply);
     }
     
-    if (!outlineRect.isEmpty() && isSelfPaintingLayer()) {
+    if (!outlineRect.isEmpty() && isSelfPaintingLayer() && !occluded) { // FYWEBKITMOD: !occluded
         // Paint our own outline
         PaintInfo paintInfo(p, outlineRect, PaintPhaseSelfOutline, false, paintingRootForRenderer, 0);
         setClip(p, paintDirtyRect, outlineRect);
@@ -2493,10 +2505,17 @@ void RenderLayer::paintLayer(RenderLayer* rootLayer, GraphicsContext* p,
     }
     
     // Paint any child layers that have overflow.
-    paintList(m_normalFlowList, rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, localPaintFlags);
+    if (!occluded) // FYWEBKITMOD
+        paintList(m_normalFlowList, rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, localPaintFlags);
     
     // Now walk the sorted list of children with positive z-indices.
-    paintList(m_posZOrderList, rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, localPaintFlags);
+    paintList(m_posZOrderList, rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, localPaintFlags, firstPosZOrderChild); // FYWEBKITMOD: firstPosZOrderChild
+
+/* FYWEBKITMOD BEGIN */
+    // Tint what we skipped, so occlusion can be checked on screen.
+    if (occluded && renderer()->document()->settings() && renderer()->document()->settings()->showOccludedPaintingOverlay())
+        p->fillRect(paintDirtyRect, Color(255, 0, 255, 64), DeviceColorSpace);
+/* FYWEBKITMOD END */
         
     if (renderer()->hasMask() && shouldPaint && !selectionOnly && !damageRect.isEmpty()) {
         setClip(p, paintDirtyRect, damageRect);
@@ -2520,12 +2539,12 @@ void RenderLayer::paintLayer(RenderLayer* rootLayer, GraphicsContext* p,
 void RenderLayer::paintList(Vector<RenderLayer*>* list, RenderLayer* rootLayer, GraphicsContext* p,
                             const IntRect& paintDirtyRect, PaintBehavior paintBehavior,
                             RenderObject* paintingRoot, OverlapTestRequestMap* overlapTestRequests,
-                            PaintLayerFlags paintFlags)
+                            PaintLayerFlags paintFlags, size_t firstIndex) // FYWEBKITMOD: firstIndex
 {
     if (!list)
         return;
     
-    for (size_t i = 0; i < list->size(); ++i) {
+    for (size_t i = firstIndex; i < list->size(); ++i) { // FYWEBKITMOD: firstIndex
         RenderLayer* childLayer = list->at(i);
         if (!childLayer->isPaginated())
             childLayer->paintLayer(rootLayer, p, paintDirtyRect, paintBehavior, paintingRoot, overlapTestRequests, paintFlags);
@@ -2534,6 +2553,68 @@ void RenderLayer::paintList(Vector<RenderLayer*>* list, RenderLayer* rootLayer,
     }
 }
 
+/* FYWEBKITMOD BEGIN */
+size_t RenderLayer::occludingPosZOrderChild(RenderLayer* rootLayer, GraphicsContext* p, const IntRect& paintDirtyRect,
+                                            PaintBehavior paintBehavior, RenderObject* paintingRoot, OverlapTestRequestMap* overlapTestRequests,
+                                            PaintLayerFlags paintFlags)
+{
+    if (!m_posZOrderList || paintDirtyRect.isEmpty())
+        return notFound;
+
+    // Painting restricted to a subtree or to the selection might not paint the
+    // occluding child at all, and overlap tests have to see every layer.
+    if (paintingRoot || overlapTestRequests || (paintBehavior & PaintBehaviorSelectionOnly) || p->updatingControlTints())
+        return notFound;
+
+    // The transparency layer is only begun when we paint our own content, and
+    // the mask is applied to whatever the positive z-order children painted.
+    // Skipping our content would composite the children without either.
+    if ((paintFlags & PaintLayerHaveTransparency) || renderer()->hasMask())
+        return notFound;
+
+    // Children of a stylesheet-pending document don't paint.
+    if (renderer()->document()->didLayoutWithPendingStylesheets())
+        return notFound;
+
+    for (size_t i = m_posZOrderList->size(); i; --i) {
+        if (m_posZOrderList->at(i - 1)->paintsOpaqueBackgroundOver(paintDirtyRect, rootLayer, paintBehavior, paintFlags))
+            return i - 1;
+    }
+    return notFound;
+}
+
+bool RenderLayer::paintsOpaqueBackgroundOver(const IntRect& rect, RenderLayer* rootLayer, PaintBehavior paintBehavior, PaintLayerFlags paintFlags) const
+{
+    if (!isSelfPaintingLayer() || !m_hasVisibleContent || isPaginated())
+        return false;
+
+#if USE(ACCELERATED_COMPOSITING)
+    // Painted into a backing of its own, if at all.
+    if (isComposited())
+        return false;
+#endif
+
+    if (paintsWithTransform(paintBehavior) || isTransparent() || m_reflection || renderer()->hasClip())
+        return false;
+
+    // Tables and fieldsets paint their background into part of the box only.
+    RenderBoxModelObject* renderer = this->renderer();
+    if (!renderer->isRenderBlock() || renderer->isTable() || renderer->isFieldset())
+        return false;
+
+    RenderBox* box = toRenderBox(renderer);
+    if (!box->backgroundIsKnownToBeOpaque())
+        return false;
+
+    int x = 0;
+    int y = 0;
+    convertToLayerCoords(rootLayer, x, y);
+    IntRect opaqueRect(x, y, box->width(), box->height());
+    opaqueRect.intersect(backgroundClipRect(rootLayer, paintFlags & PaintLayerTemporaryClipRects));
+    return opaqueRect.contains(rect);
+}
+/* FYWEBKITMOD END */
+
 void RenderLayer::paintPaginatedChildLayer(RenderLayer* childLayer, RenderLayer* rootLayer, GraphicsContext* context,
                                              const IntRect& paintDirtyRect, PaintBehavior paintBehavior,
                                              RenderObject* paintingRoot, OverlapTestRequestMap* overlapTestRequests,
@@ -484,7 +484,16 @@ private:
     void paintList(Vector<RenderLayer*>*, RenderLayer* rootLayer, GraphicsContext* p,
                    const IntRect& paintDirtyRect, PaintBehavior,
                    RenderObject* paintingRoot, OverlapTestRequestMap*,
-                   PaintLayerFlags);
+                   PaintLayerFlags, size_t firstIndex = 0); // FYWEBKITMOD: firstIndex
+/* FYWEBKITMOD BEGIN */
+    // Index of the last positive z-order child whose opaque background covers
+    // all of paintDirtyRect, or notFound. Everything painted before that child
+    // is hidden by it.
+    size_t occludingPosZOrderChild(RenderLayer* rootLayer, GraphicsContext*, const IntRect& paintDirtyRect,
+                                   PaintBehavior, RenderObject* paintingRoot, OverlapTestRequestMap*,
+                                   PaintLayerFlags);
+    bool paintsOpaqueBackgroundOver(const IntRect&, RenderLayer* rootLayer, PaintBehavior, PaintLayerFlags) const;
+/* FYWEBKITMOD END */
     void paintPaginatedChildLayer(RenderLayer* childLayer, RenderLayer* rootLayer, GraphicsContext*,
                                   const IntRect& paintDirtyRect, PaintBehavior,
                                   RenderObject* paintingRoot, OverlapTestRequestMap*,
@@ -246,6 +246,14 @@ void RenderText::deleteTextBoxes()
 {
     if (firstTextBox()) {
         RenderArena* arena = renderArena();
+/* FYWEBKITMOD BEGIN */
+        // InlineTextBoxes are trivially destructible, on document teardown the
+        // arena takes them down in bulk.
+        if (arena->canSkipFree() && documentBeingDestroyed()) {
+            m_firstTextBox = m_lastTextBox = 0;
+            return;
+        }
+/* FYWEBKITMOD END */
         InlineTextBox* next;
         for (InlineTextBox* curr = firstTextBox(); curr; curr = next) {
             next = curr->nextTextBox();
@@ -168,6 +168,15 @@ static const XMLHttpRequestStaticData* initializeXMLHttpRequestStaticData()
     return dummy;
 }
 
+// FYWEBKITMOD: Text responses with a Content-Length reserve room for up to this many
+// characters up front; longer ones grow from there.
+static const long long maximumReservedResponseTextLength = 4 * 1024 * 1024;
+
+// FYWEBKITMOD: Binary responses with a Content-Length up to this many bytes are received
+// straight into an ArrayBuffer of that size. Larger ones, where a wrong or hostile header
+// would cost the most, are collected in a SharedBuffer as they arrive.
+static const long long maximumPreallocatedBinaryResponseLength = 4 * 1024 * 1024;
+
 XMLHttpRequest::XMLHttpRequest(ScriptExecutionContext* context)
     : ActiveDOMObject(context, this)
     , m_async(true)
@@ -175,6 +184,7 @@ XMLHttpRequest::XMLHttpRequest(ScriptExecutionContext* context)
     , m_state(UNSENT)
     , m_responseText("")
     , m_createdDocument(false)
+    , m_binaryResponseLength(0) // FYWEBKITMOD
     , m_error(false)
     , m_uploadEventsAllowed(true)
     , m_uploadComplete(false)
@@ -231,6 +241,12 @@ XMLHttpRequest::State XMLHttpRequest::readyState() const
 
 const ScriptString& XMLHttpRequest::responseText() const
 {
+/* FYWEBKITMOD BEGIN */
+    // Takes the text appended since the last read, sharing the builder's buffer. The
+    // chunked text type sets m_responseText for each progress event instead.
+    if (m_responseTypeCode != ResponseTypeChunkedText && m_responseText.size() != m_responseTextBuilder.length())
+        m_responseText = m_responseTextBuilder.toStringPreserveCapacity();
+/* FYWEBKITMOD END */
     return m_responseText;
 }
 
@@ -247,7 +263,7 @@ Document* XMLHttpRequest::responseXML() const
             m_responseXML = Document::create(0, m_url);
             m_responseXML->open();
             // FIXME: Set Last-Modified.
-            m_responseXML->write(String(m_responseText));
+            m_responseXML->write(String(responseText())); // FYWEBKITMOD responseText()
             m_responseXML->finishParsing();
             m_responseXML->close();
 
@@ -263,12 +279,23 @@ Document* XMLHttpRequest::responseXML() const
 /* FYWEBKITMOD BEGIN enabling binary response of XMLHttpRequest */
 ArrayBuffer* XMLHttpRequest::responseArrayBuffer()
 {
-    ASSERT(m_responseTypeCode == ResponseTypeArrayBuffer);
+    ASSERT(m_responseTypeCode >= FirstBinaryResponseType);
+
+    // The chunked type sets m_responseArrayBuffer for each progress event.
+    if (m_responseTypeCode == ResponseTypeChunkedArrayBuffer)
+        return m_responseArrayBuffer.get();
 
     if (m_state != DONE)
         return 0;
 
-    if (!m_responseArrayBuffer.get() && m_binaryResponseBuilder.get() && m_binaryResponseBuilder->size() > 0) {
+    if (!m_responseArrayBuffer.get() && m_binaryResponseBuffer && m_binaryResponseLength) {
+        // Less data than the Content-Length announced is rare, copy it then.
+        if (m_binaryResponseLength == m_binaryResponseBuffer->byteLength())
+            m_responseArrayBuffer = m_binaryResponseBuffer;
+        else
+            m_responseArrayBuffer = ArrayBuffer::create(m_binaryResponseBuffer->data(), m_binaryResponseLength);
+        m_binaryResponseBuffer.clear();
+    } else if (!m_responseArrayBuffer.get() && m_binaryResponseBuilder.get() && m_binaryResponseBuilder->size() > 0) {
         m_responseArrayBuffer = ArrayBuffer::create(const_cast<char*>(m_binaryResponseBuilder->data()), static_cast<unsigned>(m_binaryResponseBuilder->size()));
         m_binaryResponseBuilder.clear();
     }
@@ -294,6 +321,12 @@ void XMLHttpRequest::setResponseType(const String& responseType, ExceptionCode&
         return;
     }*/
 
+    // Chunks are only handed out with progress events, which synchronous requests don't get.
+    if (!m_async && m_state >= OPENED && (responseType == "moz-chunked-text" || responseType == "moz-chunked-arraybuffer")) {
+        ec = INVALID_ACCESS_ERR;
+        return;
+    }
+
     if (responseType == "")
         m_responseTypeCode = ResponseTypeDefault;
 /*
@@ -308,6 +341,11 @@ void XMLHttpRequest::setResponseType(const String& responseType, ExceptionCode&
 */
     else if (responseType == "arraybuffer")
         m_responseTypeCode = ResponseTypeArrayBuffer;
+    // Named like Firefox's, so streaming code written for it works unchanged.
+    else if (responseType == "moz-chunked-text")
+        m_responseTypeCode = ResponseTypeChunkedText;
+    else if (responseType == "moz-chunked-arraybuffer")
+        m_responseTypeCode = ResponseTypeChunkedArrayBuffer;
     else
         ASSERT_NOT_REACHED();
 }
@@ -329,6 +367,10 @@ String XMLHttpRequest::responseType()
         */
     case ResponseTypeArrayBuffer:
         return "arraybuffer";
+    case ResponseTypeChunkedText:
+        return "moz-chunked-text";
+    case ResponseTypeChunkedArrayBuffer:
+        return "moz-chunked-arraybuffer";
     }
     return "";
 }
@@ -429,6 +471,13 @@ void XMLHttpRequest::open(const String& method, const KURL& url, bool async, Exc
         return;
     }
 
+/* FYWEBKITMOD BEGIN */
+    if (!async && isChunkedResponse()) {
+        ec = INVALID_ACCESS_ERR;
+        return;
+    }
+/* FYWEBKITMOD END */
+
     m_url = url;
 
     if (methodUpper == "COPY" || methodUpper == "DELETE" || methodUpper == "GET" || methodUpper == "HEAD"
@@ -737,6 +786,9 @@ void XMLHttpRequest::clearResponseBuffers()
 //    m_responseBlob = 0;
     m_binaryResponseBuilder.clear();
     m_responseArrayBuffer.clear();
+    m_responseTextBuilder.clear();
+    m_binaryResponseBuffer.clear();
+    m_binaryResponseLength = 0;
 //    m_responseCacheIsValid = false; NEEDED?
 /* FYWEBKITMOD END */
 }
@@ -790,7 +842,7 @@ void XMLHttpRequest::dropProtection()
     // report the extra cost at that point.
     JSC::JSGlobalData* globalData = scriptExecutionContext()->globalData();
     if (hasCachedDOMObjectWrapper(globalData, this))
-        globalData->heap.reportExtraMemoryCost(m_responseText.size() * 2);
+        globalData->heap.reportExtraMemoryCost(m_responseTextBuilder.length() * 2); // FYWEBKITMOD m_responseTextBuilder
 #endif
 
     unsetPendingActivity(this);
@@ -998,12 +1050,24 @@ void XMLHttpRequest::didFinishLoading(unsigned long identifier)
     if (m_state < HEADERS_RECEIVED)
         changeState(HEADERS_RECEIVED);
 
-    if (m_decoder)
-        m_responseText += m_decoder->flush();
+/* FYWEBKITMOD BEGIN */
+    if (m_decoder) {
+        m_responseTextBuilder.append(m_decoder->flush());
+        // Text flushed by the decoder still needs a progress event to carry it.
+        if (m_responseTypeCode == ResponseTypeChunkedText && !m_responseTextBuilder.isEmpty() && m_async) {
+            long long expectedLength = m_response.expectedContentLength();
+            m_progressEventThrottle.dispatchProgressEvent(expectedLength && m_receivedLength <= expectedLength, static_cast<unsigned>(m_receivedLength), static_cast<unsigned>(expectedLength));
+        }
+    }
+    // Lets go of the spare capacity, and of the old buffer through m_responseText.
+    m_responseTextBuilder.shrinkToFit();
+    if (m_responseTypeCode != ResponseTypeChunkedText)
+        m_responseText = m_responseTextBuilder.toStringPreserveCapacity();
+/* FYWEBKITMOD END */
 
 #if ENABLE(INSPECTOR)
     if (InspectorController* inspector = scriptExecutionContext()->inspectorController())
-        inspector->resourceRetrievedByXMLHttpRequest(identifier, m_responseText, m_url, m_lastSendURL, m_lastSendLineNumber);
+        inspector->resourceRetrievedByXMLHttpRequest(identifier, responseText(), m_url, m_lastSendURL, m_lastSendLineNumber); // FYWEBKITMOD responseText()
 #endif
 
     bool hadLoader = m_loader;
@@ -1076,16 +1140,17 @@ void XMLHttpRequest::didReceiveData(const char* data, int len)
         len = strlen(data);
 
 	if (useDecoder) { // FYWEBKITMOD conditional
-        m_responseText += m_decoder->decode(data, len);
+        /* FYWEBKITMOD BEGIN */
+        // Makes room for the whole text once instead of growing through many reallocations.
+        long long expectedLength = m_response.expectedContentLength();
+        if (m_responseTextBuilder.isEmpty() && !isChunkedResponse() && expectedLength > 0)
+            m_responseTextBuilder.reserveCapacity(static_cast<unsigned>(std::min(expectedLength, maximumReservedResponseTextLength)));
+        m_responseTextBuilder.append(m_decoder->decode(data, len));
+        /* FYWEBKITMOD END */
         }
 /* FYWEBKITMOD BEGIN enabling binary response of XMLHttpRequest */
-    else {
-		if (!m_binaryResponseBuilder)
-			{
-            m_binaryResponseBuilder = SharedBuffer::create();
-			}
-            m_binaryResponseBuilder->append(data,len);
-        }
+    else
+        appendBinaryResponse(data, len);
 /* FYWEBKITMOD END */
 
     if (!m_error) {
@@ -1105,6 +1170,60 @@ void XMLHttpRequest::didReceiveData(const char* data, int len)
         }
 }
 
+/* FYWEBKITMOD BEGIN */
+void XMLHttpRequest::appendBinaryResponse(const char* data, int length)
+{
+    // Compressed responses announce the length before decoding.
+    if (!m_binaryResponseBuffer && !m_binaryResponseBuilder && m_responseTypeCode == ResponseTypeArrayBuffer && m_response.httpHeaderField("Content-Encoding").isEmpty()) {
+        long long expectedLength = m_response.expectedContentLength();
+        if (expectedLength > 0 && expectedLength <= maximumPreallocatedBinaryResponseLength)
+            m_binaryResponseBuffer = ArrayBuffer::create(static_cast<unsigned>(expectedLength), 1);
+    }
+
+    if (m_binaryResponseBuffer) {
+        if (static_cast<unsigned>(length) <= m_binaryResponseBuffer->byteLength() - m_binaryResponseLength) {
+            memcpy(static_cast<char*>(m_binaryResponseBuffer->data()) + m_binaryResponseLength, data, length);
+            m_binaryResponseLength += length;
+            return;
+        }
+
+        // More data than announced, collect it like a response of unknown length.
+        m_binaryResponseBuilder = SharedBuffer::create(static_cast<const char*>(m_binaryResponseBuffer->data()), static_cast<int>(m_binaryResponseLength));
+        m_binaryResponseBuffer.clear();
+        m_binaryResponseLength = 0;
+    }
+
+    if (!m_binaryResponseBuilder)
+        m_binaryResponseBuilder = SharedBuffer::create();
+    m_binaryResponseBuilder->append(data, length);
+}
+
+bool XMLHttpRequest::dispatchEvent(PassRefPtr<Event> prpEvent)
+{
+    RefPtr<Event> event = prpEvent;
+    if (!isChunkedResponse() || event->type() != eventNames().progressEvent)
+        return EventTarget::dispatchEvent(event.release());
+
+    RefPtr<XMLHttpRequest> protect(this);
+
+    // Hands what was received since the previous progress event to this one, and keeps
+    // none of it afterwards.
+    if (m_responseTypeCode == ResponseTypeChunkedText) {
+        m_responseText = m_responseTextBuilder.toString();
+        m_responseTextBuilder.clear();
+    } else if (m_binaryResponseBuilder) {
+        m_responseArrayBuffer = ArrayBuffer::create(m_binaryResponseBuilder->data(), m_binaryResponseBuilder->size());
+        m_binaryResponseBuilder.clear();
+    }
+
+    bool result = EventTarget::dispatchEvent(event.release());
+
+    m_responseText = "";
+    m_responseArrayBuffer.clear();
+    return result;
+}
+/* FYWEBKITMOD END */
+
 bool XMLHttpRequest::canSuspend() const
 {
     return !m_loader;
@@ -36,6 +36,7 @@
 #include "ThreadableLoaderClient.h"
 #include "XMLHttpRequestProgressEventThrottle.h"
 #include <wtf/OwnPtr.h>
+#include <wtf/text/StringBuilder.h> // FYWEBKITMOD
 
 namespace WebCore {
 
@@ -66,16 +67,25 @@ public:
 //        ResponseTypeText,  // Not needed. Use xhr.responseText to get text repsonse
 //        ResponseTypeJSON,  // Not needed.
 //        ResponseTypeDocument, // Not needed. Use xhr.responseXML to get xml response
+        ResponseTypeChunkedText, // Text received since the previous progress event
 
         // Binary format
 //        ResponseTypeBlob, // Not needed
-        ResponseTypeArrayBuffer
+        ResponseTypeArrayBuffer,
+        ResponseTypeChunkedArrayBuffer // Bytes received since the previous progress event
     };
 	static const ResponseTypeCode FirstBinaryResponseType = ResponseTypeArrayBuffer;
 /* FYWEBKITMOD END */
 
     virtual XMLHttpRequest* toXMLHttpRequest() { return this; }
 
+/* FYWEBKITMOD BEGIN */
+    // Progress events of the chunked response types carry the data received since the
+    // previous one; response and responseText return it while the event is dispatched.
+    using EventTarget::dispatchEvent;
+    virtual bool dispatchEvent(PassRefPtr<Event>);
+/* FYWEBKITMOD END */
+
     virtual void contextDestroyed();
     virtual bool canSuspend() const;
     virtual void suspend();
@@ -181,6 +191,8 @@ private:
 
 /* FYWEBKITMOD enabling binary response of XMLHttpRequest */
 	bool shouldDecodeResponse() const { return m_responseTypeCode < FirstBinaryResponseType; }
+    bool isChunkedResponse() const { return m_responseTypeCode == ResponseTypeChunkedText || m_responseTypeCode == ResponseTypeChunkedArrayBuffer; }
+    void appendBinaryResponse(const char* data, int length);
 /* FYWEBKITMOD END */
 
     RefPtr<XMLHttpRequestUpload> m_upload;
@@ -207,13 +219,22 @@ private:
     // to be able to share the buffer with JavaScript versions of the whole or partial string.
     // In contrast, this string doesn't interact much with the rest of the engine so it's not that
     // big a cost that it isn't a String.
-    ScriptString m_responseText;
+    mutable ScriptString m_responseText; // FYWEBKITMOD mutable, taken from m_responseTextBuilder when read
     mutable bool m_createdDocument;
     mutable RefPtr<Document> m_responseXML;
 
 /* FYWEBKITMOD BEGIN enabling binary response of XMLHttpRequest */
     RefPtr<SharedBuffer> m_binaryResponseBuilder;
     mutable RefPtr<WebCore::ArrayBuffer> m_responseArrayBuffer;
+
+    // Decoded text, grown geometrically. m_responseText shares its buffer, so handing the
+    // text to script doesn't copy it.
+    StringBuilder2 m_responseTextBuilder;
+
+    // With a Content-Length of up to 4 MB, an array buffer response is allocated up front
+    // and the data is received right into it.
+    RefPtr<WebCore::ArrayBuffer> m_binaryResponseBuffer;
+    unsigned m_binaryResponseLength;
 /* FYWEBKITMOD END */
 
     bool m_error;
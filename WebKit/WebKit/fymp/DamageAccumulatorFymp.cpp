@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DamageAccumulatorFymp.h"
+
+#include "CSSPropertyNames.h"
+#include "Frame.h"
+#include "RenderBox.h"
+#include "RenderLayer.h"
+#include "RenderView.h"
+
+namespace WebKit {
+
+// Fixed cost of painting one more rect, in pixels. Two rects are merged when their union
+// adds less area than this.
+static const s64 rectCost = 32 * 32;
+
+static inline s64 area(const SkIRect & rect)
+	{
+	return static_cast<s64>(rect.width()) * rect.height();
+	}
+
+static inline SkIRect unite(const SkIRect & a, const SkIRect & b)
+	{
+	SkIRect result = a;
+	result.join(b);
+	return result;
+	}
+
+// Area painted needlessly when painting the union of both rects instead of each.
+static s64 mergeOverhead(const SkIRect & a, const SkIRect & b)
+	{
+	SkIRect overlap;
+	s64 overlapArea = overlap.intersect(a, b) ? area(overlap) : 0;
+	return area(unite(a, b)) - area(a) - area(b) + overlapArea;
+	}
+
+DamageAccumulatorFymp::DamageAccumulatorFymp(unsigned maxRects)
+	: m_maxRects(maxRects ? maxRects : 1)
+	{
+	}
+
+void DamageAccumulatorFymp::setMaxRects(unsigned maxRects)
+	{
+	m_maxRects = maxRects ? maxRects : 1;
+	mergeToLimit();
+	}
+
+void DamageAccumulatorFymp::add(const SkIRect & newRect)
+	{
+	if (newRect.isEmpty())
+		return;
+
+	++m_statistics.reportedRects;
+	m_statistics.reportedPixels += area(newRect);
+
+	SkIRect rect = newRect;
+	for (size_t i = 0; i < m_rects.size(); ++i)
+		{
+		if (m_rects[i].contains(rect))
+			return;
+		}
+
+	// Absorb everything the rect covers or is cheap to merge with. A merge grows the rect,
+	// so keep going until nothing changes.
+	bool bMerged;
+	do
+		{
+		bMerged = false;
+		for (size_t i = 0; i < m_rects.size(); )
+			{
+			if (rect.contains(m_rects[i]) || mergeOverhead(rect, m_rects[i]) < rectCost)
+				{
+				rect.join(m_rects[i]);
+				m_rects.remove(i);
+				bMerged = true;
+				}
+			else
+				++i;
+			}
+		}
+	while (bMerged);
+
+	m_rects.append(rect);
+	mergeToLimit();
+	}
+
+void DamageAccumulatorFymp::mergeToLimit()
+	{
+	while (m_rects.size() > m_maxRects)
+		{
+		size_t bestA = 0;
+		size_t bestB = 1;
+		s64 bestOverhead = mergeOverhead(m_rects[0], m_rects[1]);
+		for (size_t a = 0; a < m_rects.size(); ++a)
+			{
+			for (size_t b = a + 1; b < m_rects.size(); ++b)
+				{
+				s64 overhead = mergeOverhead(m_rects[a], m_rects[b]);
+				if (overhead < bestOverhead)
+					{
+					bestOverhead = overhead;
+					bestA = a;
+					bestB = b;
+					}
+				}
+			}
+		m_rects[bestA].join(m_rects[bestB]);
+		m_rects.remove(bestB);
+		}
+	}
+
+void DamageAccumulatorFymp::take(Vector<SkIRect> & rects)
+	{
+	rects.clear();
+	++m_statistics.frames;
+
+	SkRegion occluded;
+	for (size_t i = 0; i < m_occluders.size(); ++i)
+		occluded.op(m_occluders[i], SkRegion::kUnion_Op);
+	m_occluders.clear();
+
+	// Held back damage that is no longer covered is due now.
+	if (!m_covered.isEmpty())
+		{
+		SkRegion uncovered;
+		uncovered.op(m_covered, occluded, SkRegion::kDifference_Op);
+		m_covered.op(occluded, SkRegion::kIntersect_Op);
+		for (SkRegion::Iterator it(uncovered); !it.done(); it.next())
+			{
+			// Already counted when it was reported.
+			--m_statistics.reportedRects;
+			m_statistics.reportedPixels -= area(it.rect());
+			add(it.rect());
+			}
+		}
+
+	for (size_t i = 0; i < m_rects.size(); ++i)
+		{
+		const SkIRect & rect = m_rects[i];
+		if (occluded.contains(rect))
+			{
+			m_covered.op(rect, SkRegion::kUnion_Op);
+			m_statistics.occludedPixels += area(rect);
+			continue;
+			}
+		rects.append(rect);
+		m_statistics.damagePixels += area(rect);
+		}
+	m_statistics.damageRects += rects.size();
+	m_rects.clear();
+	}
+
+// Layers with transforms or opacity, and anything inside an overflow clip, have bounds we
+// can't tell exactly without doing the compositor's work; they never occlude.
+static void collectOpaqueLayers(WebCore::RenderLayer *pLayer, Vector<SkIRect> & rects)
+	{
+	for (WebCore::RenderLayer *pChild = pLayer->firstChild(); pChild; pChild = pChild->nextSibling())
+		{
+		WebCore::RenderBoxModelObject *pRenderer = pChild->renderer();
+		if (pChild->hasTransform() || pChild->isTransparent() || pRenderer->hasClip())
+			continue;
+
+		const WebCore::RenderStyle *pStyle = pRenderer->style();
+		WebCore::Color backgroundColor = pStyle->visitedDependentColor(CSSPropertyBackgroundColor);
+		if (pChild->isComposited() && pChild->zIndex() >= 0 && pRenderer->isBox()
+			&& pStyle->visibility() == WebCore::VISIBLE && !pStyle->hasBorderRadius()
+			&& pStyle->backgroundClip() == WebCore::BorderFillBox && backgroundColor.isValid() && !backgroundColor.hasAlpha())
+			{
+			WebCore::RenderBox *pBox = WebCore::toRenderBox(pRenderer);
+			WebCore::IntPoint origin = WebCore::roundedIntPoint(pBox->localToAbsolute());
+			SkIRect rect;
+			rect.set(origin.x(), origin.y(), origin.x() + pBox->width(), origin.y() + pBox->height());
+			if (!rect.isEmpty())
+				rects.append(rect);
+			}
+
+		if (!pRenderer->hasOverflowClip())
+			collectOpaqueLayers(pChild, rects);
+		}
+	}
+
+void DamageAccumulatorFymp::collectOpaqueLayerRects(WebCore::Frame *pFrame, Vector<SkIRect> & rects)
+	{
+	WebCore::RenderView *pRenderView = pFrame ? pFrame->contentRenderer() : 0;
+	if (!pRenderView || !pRenderView->layer())
+		return;
+
+#if USE(ACCELERATED_COMPOSITING)
+	if (!pRenderView->usesCompositing())
+		return;
+	collectOpaqueLayers(pRenderView->layer(), rects);
+#endif
+	}
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DamageAccumulatorFymp_h
+#define DamageAccumulatorFymp_h
+
+#include "WebViewFymp.h"
+
+#include "SkRect.h"
+#include "SkRegion.h"
+
+#include <wtf/Vector.h>
+
+namespace WebCore {
+	class Frame;
+}
+
+namespace WebKit {
+
+/*
+	Collects the rects invalidated during a frame into a small set.
+
+	WebCore reports every repainted renderer separately, which for pages with many small
+	animated elements means hundreds of tiny rects per frame. Each painted rect has a fixed
+	setup cost, so rects are merged whenever painting their union is cheaper than painting
+	both, and always once there are more than maxRects() of them.
+
+	Rects that will be completely hidden by opaque content drawn on top of the page (see
+	collectOpaqueLayerRects()) are held back instead of being reported, until a later frame
+	no longer covers them.
+*/
+class DamageAccumulatorFymp
+	{
+public:
+	DamageAccumulatorFymp(unsigned maxRects = 16);
+
+	void setMaxRects(unsigned maxRects);
+	unsigned maxRects() const { return m_maxRects; }
+
+	void add(const SkIRect & rect);
+	bool isEmpty() const { return m_rects.isEmpty() && m_covered.isEmpty(); }
+
+	// Areas covered by opaque content when the next damage is presented.
+	void setOccluders(const Vector<SkIRect> & occluders) { m_occluders = occluders; }
+
+	// Returns the damage of the frame and starts a new one.
+	void take(Vector<SkIRect> & rects);
+
+	const DamageStatistics & statistics() const { return m_statistics; }
+
+	// Bounds of composited layers (in main frame content coordinates) that the compositor
+	// draws opaquely on top of the page contents.
+	static void collectOpaqueLayerRects(WebCore::Frame *pFrame, Vector<SkIRect> & rects);
+
+private:
+	void mergeToLimit();
+
+	unsigned			m_maxRects;
+	Vector<SkIRect>		m_rects;
+	Vector<SkIRect>		m_occluders;
+	SkRegion			m_covered;		//!< damage held back while it is occluded
+
+	DamageStatistics	m_statistics;
+	};
+
+}
+
+#endif
@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "NativeBindingFymp.h"
+
+#include "APIShims.h"
+#include "ArrayBuffer.h"
+#include "ArrayBufferView.h"
+#include "JSArrayBuffer.h"
+#include "JSArrayBufferView.h"
+#include "npruntime.h"
+
+#include <JavaScriptCore/APICast.h>
+#include <runtime/JSArray.h>
+#include <runtime/JSByteArray.h>
+#include <runtime/JSGlobalObject.h>
+#include <runtime/JSString.h>
+#include <wtf/MathExtras.h>
+#include <wtf/Vector.h>
+
+namespace WebKit {
+
+using namespace JSC;
+
+JSClassRef NativeBindingFymp::createClass(const char *pClassName, const JSStaticFunction *pFunctions, const JSStaticValue *pValues, JSObjectFinalizeCallback finalize)
+	{
+	JSClassDefinition definition = kJSClassDefinitionEmpty;
+	definition.attributes = kJSClassAttributeNoAutomaticPrototype;
+	definition.className = pClassName;
+	definition.staticFunctions = pFunctions;
+	definition.staticValues = pValues;
+	definition.finalize = finalize;
+	return JSClassCreate(&definition);
+	}
+
+bool NativeBindingFymp::getCharacters(JSContextRef ctx, JSValueRef value, const JSChar *& pCharacters, size_t & length)
+	{
+	ExecState *exec = toJS(ctx);
+	APIEntryShim entryShim(exec);
+
+	JSValue jsValue = toJS(exec, value);
+	if (!jsValue.isString())
+		return false;
+
+	// Resolves a rope in place; the characters stay owned by the string cell, which the
+	// caller's argument list keeps alive.
+	const UString & string = asString(jsValue)->value(exec);
+	pCharacters = reinterpret_cast<const JSChar*>(string.data());
+	length = string.size();
+	return true;
+	}
+
+bool NativeBindingFymp::getBytes(JSContextRef ctx, JSValueRef value, u8 *& pData, size_t & length)
+	{
+	ExecState *exec = toJS(ctx);
+	APIEntryShim entryShim(exec);
+
+	JSValue jsValue = toJS(exec, value);
+	if (WebCore::ArrayBuffer *pBuffer = WebCore::toArrayBuffer(jsValue))
+		{
+		pData = static_cast<u8*>(pBuffer->data());
+		length = pBuffer->byteLength();
+		return true;
+		}
+
+	if (WebCore::ArrayBufferView *pView = WebCore::toArrayBufferView(jsValue))
+		{
+		pData = static_cast<u8*>(pView->baseAddress());
+		length = pView->byteLength();
+		return true;
+		}
+
+	if (!isJSByteArray(&exec->globalData(), jsValue))
+		return false;
+
+	WTF::ByteArray *pStorage = asByteArray(jsValue)->storage();
+	pData = pStorage->data();
+	length = pStorage->length();
+	return true;
+	}
+
+bool NativeBindingFymp::copyNumbers(JSContextRef ctx, JSValueRef value, double *pValues, size_t maxCount, size_t & length, JSValueRef *pException)
+	{
+	ExecState *exec = toJS(ctx);
+	APIEntryShim entryShim(exec);
+
+	JSValue jsValue = toJS(exec, value);
+	if (!isJSArray(&exec->globalData(), jsValue))
+		return false;
+
+	JSArray *pArray = asArray(jsValue);
+	length = pArray->length();
+	size_t count = std::min<size_t>(length, maxCount);
+	for (unsigned i = 0; i < count; ++i)
+		{
+		// Holes and elements beyond the vector take the generic path through the prototype.
+		JSValue element = pArray->canGetIndex(i) ? pArray->getIndex(i) : pArray->get(exec, i);
+		pValues[i] = element.isNumber() ? element.uncheckedGetNumber() : element.toNumber(exec);
+		if (exec->hadException())
+			{
+			if (pException)
+				*pException = toRef(exec, exec->exception());
+			exec->clearException();
+			return false;
+			}
+		}
+	return true;
+	}
+
+JSObjectRef NativeBindingFymp::makeNumberArray(JSContextRef ctx, const double *pValues, size_t count)
+	{
+	ExecState *exec = toJS(ctx);
+	APIEntryShim entryShim(exec);
+
+	JSArray *pArray = new (exec) JSArray(exec->lexicalGlobalObject()->arrayStructure(), count, CreateCompact);
+	for (size_t i = 0; i < count; ++i)
+		{
+		// Same NaN normalization as JSValueMakeNumber().
+		double number = isnan(pValues[i]) ? NaN : pValues[i];
+		pArray->uncheckedSetIndex(i, jsNumber(exec, number));
+		}
+	pArray->setLength(count);
+	return toRef(pArray);
+	}
+
+// Benchmark objects. Both offer the same functions: noop(), add(a, b), sum(numbers) and
+// length(string).
+
+static double argumentNumber(JSContextRef ctx, size_t argumentCount, const JSValueRef arguments[], size_t index, JSValueRef *pException)
+	{
+	return index < argumentCount ? JSValueToNumber(ctx, arguments[index], pException) : NaN;
+	}
+
+static JSValueRef nativeNoop(JSContextRef ctx, JSObjectRef, JSObjectRef, size_t, const JSValueRef[], JSValueRef *)
+	{
+	return JSValueMakeUndefined(ctx);
+	}
+
+static JSValueRef nativeAdd(JSContextRef ctx, JSObjectRef, JSObjectRef, size_t argumentCount, const JSValueRef arguments[], JSValueRef *pException)
+	{
+	double a = argumentNumber(ctx, argumentCount, arguments, 0, pException);
+	double b = argumentNumber(ctx, argumentCount, arguments, 1, pException);
+	return JSValueMakeNumber(ctx, a + b);
+	}
+
+static JSValueRef nativeSum(JSContextRef ctx, JSObjectRef, JSObjectRef, size_t argumentCount, const JSValueRef arguments[], JSValueRef *pException)
+	{
+	Vector<double, 256> values(256);
+	size_t length;
+	if (!argumentCount || !NativeBindingFymp::copyNumbers(ctx, arguments[0], values.data(), values.size(), length, pException))
+		return JSValueMakeUndefined(ctx);
+	if (length > values.size())
+		{
+		values.resize(length);
+		if (!NativeBindingFymp::copyNumbers(ctx, arguments[0], values.data(), values.size(), length, pException))
+			return JSValueMakeUndefined(ctx);
+		}
+
+	double sum = 0;
+	for (size_t i = 0; i < length; ++i)
+		sum += values[i];
+	return JSValueMakeNumber(ctx, sum);
+	}
+
+static JSValueRef nativeLength(JSContextRef ctx, JSObjectRef, JSObjectRef, size_t argumentCount, const JSValueRef arguments[], JSValueRef *)
+	{
+	const JSChar *pCharacters;
+	size_t length;
+	if (!argumentCount || !NativeBindingFymp::getCharacters(ctx, arguments[0], pCharacters, length))
+		return JSValueMakeUndefined(ctx);
+	return JSValueMakeNumber(ctx, static_cast<double>(length));
+	}
+
+static const JSStaticFunction benchmarkFunctions[] =
+	{
+	{ "noop", nativeNoop, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete },
+	{ "add", nativeAdd, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete },
+	{ "sum", nativeSum, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete },
+	{ "length", nativeLength, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete },
+	{ 0, 0, 0 }
+	};
+
+JSObjectRef NativeBindingFymp::createBenchmarkObject(JSContextRef ctx)
+	{
+	static JSClassRef benchmarkClass = createClass("FympBindingBenchmark", benchmarkFunctions);
+	return JSObjectMake(ctx, benchmarkClass, 0);
+	}
+
+// The NPObject version does what a host service behind addToJavaScriptWindowObject() has
+// to do for the same work.
+
+enum NPBenchmarkMethod { NPNoop, NPAdd, NPSum, NPLength, NPMethodCount };
+
+static int npMethodIndex(NPIdentifier name)
+	{
+	static const char *const methodNames[NPMethodCount] = { "noop", "add", "sum", "length" };
+	static NPIdentifier methodIdentifiers[NPMethodCount];
+	if (!methodIdentifiers[0])
+		{
+		for (int i = 0; i < NPMethodCount; ++i)
+			methodIdentifiers[i] = NPN_GetStringIdentifier(methodNames[i]);
+		}
+
+	for (int i = 0; i < NPMethodCount; ++i)
+		{
+		if (methodIdentifiers[i] == name)
+			return i;
+		}
+	return -1;
+	}
+
+static double npNumber(const NPVariant & variant)
+	{
+	if (NPVARIANT_IS_DOUBLE(variant))
+		return NPVARIANT_TO_DOUBLE(variant);
+	if (NPVARIANT_IS_INT32(variant))
+		return NPVARIANT_TO_INT32(variant);
+	return NaN;
+	}
+
+static double npArgument(const NPVariant *pArguments, uint32_t argumentCount, uint32_t index)
+	{
+	return index < argumentCount ? npNumber(pArguments[index]) : NaN;
+	}
+
+static bool npHasMethod(NPObject *, NPIdentifier name)
+	{
+	return npMethodIndex(name) >= 0;
+	}
+
+static bool npInvoke(NPObject *, NPIdentifier name, const NPVariant *pArguments, uint32_t argumentCount, NPVariant *pResult)
+	{
+	VOID_TO_NPVARIANT(*pResult);
+	switch (npMethodIndex(name))
+		{
+		case NPNoop:
+			return true;
+
+		case NPAdd:
+			DOUBLE_TO_NPVARIANT(npArgument(pArguments, argumentCount, 0) + npArgument(pArguments, argumentCount, 1), *pResult);
+			return true;
+
+		case NPSum:
+			{
+			if (!argumentCount || !NPVARIANT_IS_OBJECT(pArguments[0]))
+				return true;
+			NPObject *pArray = NPVARIANT_TO_OBJECT(pArguments[0]);
+			NPVariant lengthVariant;
+			if (!NPN_GetProperty(0, pArray, NPN_GetStringIdentifier("length"), &lengthVariant))
+				return true;
+			int32_t length = static_cast<int32_t>(npNumber(lengthVariant));
+			NPN_ReleaseVariantValue(&lengthVariant);
+
+			double sum = 0;
+			for (int32_t i = 0; i < length; ++i)
+				{
+				NPVariant element;
+				if (!NPN_GetProperty(0, pArray, NPN_GetIntIdentifier(i), &element))
+					continue;
+				sum += npNumber(element);
+				NPN_ReleaseVariantValue(&element);
+				}
+			DOUBLE_TO_NPVARIANT(sum, *pResult);
+			return true;
+			}
+
+		case NPLength:
+			// The bridge hands strings over as UTF-8 copies; for ASCII text the byte count
+			// is the character count.
+			if (argumentCount && NPVARIANT_IS_STRING(pArguments[0]))
+				DOUBLE_TO_NPVARIANT(NPVARIANT_TO_STRING(pArguments[0]).UTF8Length, *pResult);
+			return true;
+		}
+	return false;
+	}
+
+static NPClass npBenchmarkClass =
+	{
+	NP_CLASS_STRUCT_VERSION,
+	0,				// allocate
+	0,				// deallocate
+	0,				// invalidate
+	npHasMethod,
+	npInvoke,
+	0,				// invokeDefault
+	0,				// hasProperty
+	0,				// getProperty
+	0,				// setProperty
+	0,				// removeProperty
+	0,				// enumerate
+	0				// construct
+	};
+
+NPObject *NativeBindingFymp::createNPBenchmarkObject()
+	{
+	return NPN_CreateObject(0, &npBenchmarkClass);
+	}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef NativeBindingFymp_h
+#define NativeBindingFymp_h
+
+#include "WebViewFymp.h"
+
+#include <JavaScriptCore/JavaScript.h>
+
+namespace WebKit {
+
+/*
+	Helpers for host objects bound through the JavaScriptCore C API.
+
+	WebViewFymp::addToJavaScriptWindowObject() goes through the NPObject bridge: every call
+	looks up NPIdentifiers, converts each argument into an NPVariant (copying strings) and
+	the result back. Objects added with WebViewFymp::addNativeObject() are plain
+	JSClassRef instances instead; their callbacks get the JSValueRefs of the call directly.
+
+	The functions below cover the argument types where the C API itself would still copy:
+	strings are read in place, number arrays are copied in one go and binary data is
+	accessed directly. Pointers handed out stay valid until the callback returns.
+*/
+class FYMP_PRXSYM_WEBKIT NativeBindingFymp
+	{
+public:
+	// Class for a static function (and value) table. Both tables are terminated by an
+	// entry with a null name; their names are hashed once, when the first object is
+	// created. The functions live on the objects themselves rather than on a prototype,
+	// which saves a lookup per call.
+	static JSClassRef createClass(const char *pClassName, const JSStaticFunction *pFunctions, const JSStaticValue *pValues = 0, JSObjectFinalizeCallback finalize = 0);
+
+	// Characters of a string value, without copying them.
+	static bool getCharacters(JSContextRef ctx, JSValueRef value, const JSChar *& pCharacters, size_t & length);
+
+	// Bytes of an ArrayBuffer, of the range an ArrayBufferView (Uint8Array etc.) covers,
+	// or of the pixels of an ImageData (its data array), writable.
+	static bool getBytes(JSContextRef ctx, JSValueRef value, u8 *& pData, size_t & length);
+
+	// Copies up to maxCount elements of an array into pValues, converting them to numbers
+	// like JSValueToNumber() would. length receives the length of the array, which may be
+	// larger than maxCount. Fails if the value is not an array or a conversion threw.
+	static bool copyNumbers(JSContextRef ctx, JSValueRef value, double *pValues, size_t maxCount, size_t & length, JSValueRef *pException);
+	static JSObjectRef makeNumberArray(JSContextRef ctx, const double *pValues, size_t count);
+
+	// Same objects the benchmark in WebCore/benchmarks/bindings uses to compare both paths.
+	static JSObjectRef createBenchmarkObject(JSContextRef ctx);
+	static NPObject *createNPBenchmarkObject();
+	};
+
+}
+
+#endif
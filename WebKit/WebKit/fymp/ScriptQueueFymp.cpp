@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "ScriptQueueFymp.h"
+
+#include "Frame.h"
+#include "ScriptController.h"
+
+#include <JavaScriptCore/APICast.h>
+#include <string.h>
+#include <string>
+
+namespace WebKit {
+
+// Runs calls = [function, arguments, function, arguments, ...] and returns
+// [result, threw, result, threw, ...]. An exception only ends its own message.
+static const char dispatcherSource[] =
+	"(function(calls) {"
+	"    var results = [];"
+	"    for (var i = 0; i < calls.length; i += 2) {"
+	"        try {"
+	"            results.push(calls[i].apply(undefined, calls[i + 1]), false);"
+	"        } catch (e) {"
+	"            results.push(e, true);"
+	"        }"
+	"    }"
+	"    return results;"
+	"})";
+
+static JSObjectRef compileFunction(JSGlobalContextRef ctx, const char *pSource)
+	{
+	JSStringRef source = JSStringCreateWithUTF8CString(pSource);
+	JSValueRef value = JSEvaluateScript(ctx, source, 0, 0, 1, 0);
+	JSStringRelease(source);
+
+	if (!value || !JSValueIsObject(ctx, value))
+		return 0;
+	JSObjectRef function = JSValueToObject(ctx, value, 0);
+	if (!JSObjectIsFunction(ctx, function))
+		return 0;
+	JSValueProtect(ctx, function);
+	return function;
+	}
+
+ScriptQueueFymp::ScriptQueueFymp()
+	: m_nextHandle(1)
+	, m_bDelivering(false)
+	, m_bDestroyPending(false)
+	{
+	}
+
+ScriptQueueFymp::~ScriptQueueFymp()
+	{
+	for (size_t i = 0; i < m_messages.size(); ++i)
+		drop(m_messages[i]);
+	m_messages.clear();
+
+	for (ScriptMap::iterator it = m_scripts.begin(); it != m_scripts.end(); ++it)
+		JSValueUnprotect(it->second.ctx, it->second.function);
+	for (DispatcherMap::iterator it = m_dispatchers.begin(); it != m_dispatchers.end(); ++it)
+		JSValueUnprotect(it->first, it->second);
+	}
+
+void ScriptQueueFymp::destroy()
+	{
+	if (m_bDelivering)
+		m_bDestroyPending = true;
+	else
+		delete this;
+	}
+
+ScriptHandleFymp ScriptQueueFymp::registerScript(WebCore::Frame *pFrame, JSGlobalContextRef ctx, const char *pFunctionSource)
+	{
+	// The function expression needs parentheses to be an expression statement.
+	std::string source;
+	source.reserve(strlen(pFunctionSource) + 2);
+	source += '(';
+	source += pFunctionSource;
+	source += ')';
+
+	JSObjectRef function = compileFunction(ctx, source.c_str());
+	if (!function)
+		return 0;
+
+	Script script;
+	script.frame = pFrame;
+	script.ctx = ctx;
+	script.function = function;
+
+	ScriptHandleFymp handle = m_nextHandle++;
+	m_scripts.set(handle, script);
+	return handle;
+	}
+
+void ScriptQueueFymp::unregisterScript(ScriptHandleFymp handle)
+	{
+	ScriptMap::iterator it = m_scripts.find(handle);
+	if (it == m_scripts.end())
+		return;
+	JSValueUnprotect(it->second.ctx, it->second.function);
+	m_scripts.remove(it);
+	}
+
+void ScriptQueueFymp::post(ScriptHandleFymp handle, const ScriptArgumentFymp *pArguments, u32 argumentCount, ScriptResultCallbackFymp callback, void *pContext)
+	{
+	Message *pMessage = new Message;
+	pMessage->handle = handle;
+	pMessage->callback = callback;
+	pMessage->pContext = pContext;
+	pMessage->arguments.resize(argumentCount);
+	for (u32 i = 0; i < argumentCount; ++i)
+		{
+		Argument & argument = pMessage->arguments[i];
+		argument.type = pArguments[i].type;
+		argument.number = pArguments[i].number;
+		// Converted once here; the JS string is made from it without going through UTF-8 again.
+		argument.string = argument.type == ScriptArgumentFymp::String ? JSStringCreateWithUTF8CString(pArguments[i].pString ? pArguments[i].pString : "") : 0;
+		}
+	m_messages.append(pMessage);
+	}
+
+void ScriptQueueFymp::drop(Message *pMessage)
+	{
+	for (size_t i = 0; i < pMessage->arguments.size(); ++i)
+		{
+		if (pMessage->arguments[i].string)
+			JSStringRelease(pMessage->arguments[i].string);
+		}
+	delete pMessage;
+	}
+
+bool ScriptQueueFymp::isCurrent(const Script & script) const
+	{
+	WebCore::Frame *pFrame = script.frame.get();
+	if (!pFrame->page())
+		return false;
+	return toGlobalRef(pFrame->script()->globalObject(WebCore::mainThreadNormalWorld())->globalExec()) == script.ctx;
+	}
+
+JSObjectRef ScriptQueueFymp::dispatcher(JSGlobalContextRef ctx)
+	{
+	JSObjectRef function = m_dispatchers.get(ctx);
+	if (!function)
+		{
+		function = compileFunction(ctx, dispatcherSource);
+		if (function)
+			m_dispatchers.set(ctx, function);
+		}
+	return function;
+	}
+
+// Scripts and dispatchers keep their global object alive after the frame has navigated
+// away from it. Stale scripts can never run again, their handles behave like unregistered
+// ones from now on.
+void ScriptQueueFymp::dropStaleScripts()
+	{
+	HashSet<JSGlobalContextRef> current;
+	Vector<ScriptHandleFymp> staleScripts;
+	for (ScriptMap::iterator it = m_scripts.begin(); it != m_scripts.end(); ++it)
+		{
+		if (isCurrent(it->second))
+			current.add(it->second.ctx);
+		else
+			staleScripts.append(it->first);
+		}
+	for (size_t i = 0; i < staleScripts.size(); ++i)
+		unregisterScript(staleScripts[i]);
+
+	Vector<JSGlobalContextRef> stale;
+	for (DispatcherMap::iterator it = m_dispatchers.begin(); it != m_dispatchers.end(); ++it)
+		{
+		if (!current.contains(it->first))
+			stale.append(it->first);
+		}
+	for (size_t i = 0; i < stale.size(); ++i)
+		JSValueUnprotect(stale[i], m_dispatchers.take(stale[i]));
+	}
+
+u32 ScriptQueueFymp::deliver()
+	{
+	if (m_messages.isEmpty() || m_bDelivering)
+		return 0;
+	m_bDelivering = true;
+
+	// Messages posted by the callbacks wait for the next frame.
+	Vector<Message*> messages;
+	messages.swap(m_messages);
+
+	// Group by global object, keeping the posting order within each.
+	Vector<JSGlobalContextRef> contexts;
+	HashMap<JSGlobalContextRef, Vector<Message*> > groups;
+	bool bSawStale = false;
+	for (size_t i = 0; i < messages.size(); ++i)
+		{
+		Message *pMessage = messages[i];
+		if (m_bDestroyPending)
+			{
+			drop(pMessage);
+			continue;
+			}
+
+		ScriptMap::iterator it = m_scripts.find(pMessage->handle);
+		if (it == m_scripts.end() || !isCurrent(it->second))
+			{
+			bSawStale = true;
+			if (pMessage->callback)
+				pMessage->callback(pMessage->pContext, 0, 0, false);
+			drop(pMessage);
+			continue;
+			}
+
+		JSGlobalContextRef ctx = it->second.ctx;
+		HashMap<JSGlobalContextRef, Vector<Message*> >::iterator group = groups.find(ctx);
+		if (group == groups.end())
+			{
+			contexts.append(ctx);
+			group = groups.add(ctx, Vector<Message*>()).first;
+			}
+		group->second.append(pMessage);
+		}
+
+	u32 delivered = 0;
+	for (size_t i = 0; i < contexts.size(); ++i)
+		{
+		Vector<Message*> group = groups.get(contexts[i]);
+		if (!m_bDestroyPending)
+			{
+			deliver(contexts[i], group);
+			delivered += group.size();
+			}
+		for (size_t j = 0; j < group.size(); ++j)
+			drop(group[j]);
+		}
+
+	if (bSawStale && !m_bDestroyPending)
+		dropStaleScripts();
+
+	m_bDelivering = false;
+	if (m_bDestroyPending)
+		delete this;
+	return delivered;
+	}
+
+void ScriptQueueFymp::deliver(JSGlobalContextRef ctx, const Vector<Message*> & messages)
+	{
+	JSObjectRef function = dispatcher(ctx);
+	if (!function)
+		return;
+
+	// Every value goes into the array as soon as it is made: the collector doesn't see
+	// JSValueRefs held in heap memory, only those on the stack.
+	JSObjectRef calls = JSObjectMakeArray(ctx, 0, 0, 0);
+	unsigned callIndex = 0;
+	Vector<bool> dropped(messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+		{
+		const Message *pMessage = messages[i];
+		// A callback of an earlier frame may have unregistered the script meanwhile. The
+		// message is dropped then; undefined keeps its slot in the calls array.
+		ScriptMap::iterator script = m_scripts.find(pMessage->handle);
+		dropped[i] = script == m_scripts.end();
+		JSValueRef scriptFunction = !dropped[i] ? script->second.function : JSValueMakeUndefined(ctx);
+		JSObjectSetPropertyAtIndex(ctx, calls, callIndex++, scriptFunction, 0);
+
+		JSObjectRef arguments = JSObjectMakeArray(ctx, 0, 0, 0);
+		JSObjectSetPropertyAtIndex(ctx, calls, callIndex++, arguments, 0);
+		for (size_t j = 0; j < pMessage->arguments.size(); ++j)
+			{
+			const Argument & argument = pMessage->arguments[j];
+			JSValueRef value;
+			switch (argument.type)
+				{
+				case ScriptArgumentFymp::Number:
+					value = JSValueMakeNumber(ctx, argument.number);
+					break;
+				case ScriptArgumentFymp::Boolean:
+					value = JSValueMakeBoolean(ctx, argument.number != 0);
+					break;
+				case ScriptArgumentFymp::String:
+					value = JSValueMakeString(ctx, argument.string);
+					break;
+				default:
+					value = JSValueMakeUndefined(ctx);
+					break;
+				}
+			JSObjectSetPropertyAtIndex(ctx, arguments, j, value, 0);
+			}
+		}
+
+	JSValueRef callsValue = calls;
+	JSValueRef exception = 0;
+	JSValueRef resultsValue = JSObjectCallAsFunction(ctx, function, 0, 1, &callsValue, &exception);
+	JSObjectRef results = resultsValue && JSValueIsObject(ctx, resultsValue) ? JSValueToObject(ctx, resultsValue, 0) : 0;
+
+	for (size_t i = 0; i < messages.size(); ++i)
+		{
+		const Message *pMessage = messages[i];
+		if (!pMessage->callback)
+			continue;
+		if (dropped[i])
+			{
+			pMessage->callback(pMessage->pContext, 0, 0, false);
+			continue;
+			}
+		if (!results)
+			{
+			pMessage->callback(pMessage->pContext, ctx, exception, true);
+			continue;
+			}
+		JSValueRef result = JSObjectGetPropertyAtIndex(ctx, results, 2 * i, 0);
+		bool bException = JSValueToBoolean(ctx, JSObjectGetPropertyAtIndex(ctx, results, 2 * i + 1, 0));
+		pMessage->callback(pMessage->pContext, ctx, result, bException);
+		}
+	}
+
+}
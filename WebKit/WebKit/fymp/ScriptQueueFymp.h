@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ScriptQueueFymp_h
+#define ScriptQueueFymp_h
+
+#include "WebViewFymp.h"
+
+#include <JavaScriptCore/JavaScript.h>
+
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebKit {
+
+/*
+	Precompiled scripts and the queue of host to JS messages of one view.
+
+	evaluateJavaScript() parses and compiles its source on every call and converts the
+	result into an NPVariant. A registered script is compiled once into a function object
+	that stays protected from the garbage collector until it is unregistered. Messages for
+	it are queued with their arguments; deliver() hands all messages of a frame to a small
+	dispatcher function in one call, so the host enters JS once per frame however many
+	messages there are. Results go back to the message's callback as JSValueRefs.
+
+	A script belongs to the global object of its frame at registration. Once the frame has
+	navigated, the handle is stale and its messages are dropped.
+
+	Result callbacks may post, unregister and even destroy the queue; deliver() itself is
+	not reentered.
+*/
+class ScriptQueueFymp : public Noncopyable
+	{
+public:
+	ScriptQueueFymp();
+	~ScriptQueueFymp();
+
+	// Deletes the queue, or, if called from a callback of deliver(), once deliver() returns.
+	void destroy();
+
+	ScriptHandleFymp registerScript(WebCore::Frame *pFrame, JSGlobalContextRef ctx, const char *pFunctionSource);
+	void unregisterScript(ScriptHandleFymp handle);
+
+	void post(ScriptHandleFymp handle, const ScriptArgumentFymp *pArguments, u32 argumentCount, ScriptResultCallbackFymp callback, void *pContext);
+
+	// Returns the number of messages that were run.
+	u32 deliver();
+
+private:
+	struct Script
+		{
+		RefPtr<WebCore::Frame>		frame;
+		JSGlobalContextRef			ctx;
+		JSObjectRef					function;
+		};
+
+	struct Argument
+		{
+		ScriptArgumentFymp::Type	type;
+		double						number;
+		JSStringRef					string;
+		};
+
+	struct Message
+		{
+		ScriptHandleFymp			handle;
+		Vector<Argument>			arguments;
+		ScriptResultCallbackFymp	callback;
+		void *						pContext;
+		};
+
+	bool isCurrent(const Script & script) const;
+	JSObjectRef dispatcher(JSGlobalContextRef ctx);
+	void dropStaleScripts();
+	void deliver(JSGlobalContextRef ctx, const Vector<Message*> & messages);
+	void drop(Message *pMessage);
+
+	typedef HashMap<ScriptHandleFymp, Script> ScriptMap;
+	typedef HashMap<JSGlobalContextRef, JSObjectRef> DispatcherMap;
+
+	ScriptMap					m_scripts;
+	DispatcherMap				m_dispatchers;		//!< per global object, protected
+	Vector<Message*>			m_messages;
+	ScriptHandleFymp			m_nextHandle;
+	bool						m_bDelivering;
+	bool						m_bDestroyPending;	//!< destroy() was called during deliver()
+	};
+
+}
+
+#endif
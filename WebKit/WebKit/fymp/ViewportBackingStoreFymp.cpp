@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ViewportBackingStoreFymp.h"
+
+#include "Color.h"
+#include "Frame.h"
+#include "FrameView.h"
+#include "GraphicsContext.h"
+#include "Page.h"
+#include "PlatformContextSkia.h"
+#include "RenderBox.h"
+#include "RenderView.h"
+
+#include "SkBitmap.h"
+#include "SkDevice.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <wtf/CurrentTime.h>
+
+namespace WebKit {
+
+static inline u64 area(const SkIRect & rect)
+	{
+	return static_cast<u64>(rect.width()) * rect.height();
+	}
+
+ViewportBackingStoreFymp::ViewportBackingStoreFymp(WebViewFymp *pView)
+	: m_pView(pView)
+	, m_bValid(false)
+	{
+	m_viewport.setEmpty();
+	m_fixedBounds.setEmpty();
+	m_pView->addListener(this);
+	}
+
+ViewportBackingStoreFymp::~ViewportBackingStoreFymp()
+	{
+	m_pView->removeListener(this);
+	}
+
+void ViewportBackingStoreFymp::needRepaint(SkIRect & rect)
+	{
+	if (m_bValid)
+		m_dirty.add(rect);
+	}
+
+bool ViewportBackingStoreFymp::resize(int width, int height)
+	{
+	m_context.clear();
+	m_platformContext.clear();
+	m_canvas.clear();
+	m_bValid = false;
+
+	// Same setup as ImageBufferSkia: a raster canvas wrapped into a GraphicsContext.
+	m_canvas.set(new skia::PlatformCanvas);
+	if (!m_canvas->initialize(width, height, true))
+		{
+		m_canvas.clear();
+		return false;
+		}
+	m_platformContext.set(new PlatformContextSkia(m_canvas.get()));
+	m_context.set(new WebCore::GraphicsContext(m_platformContext.get()));
+	return true;
+	}
+
+// Moves the retained pixels by (dx, dy), leaving the uncovered strips undefined.
+bool ViewportBackingStoreFymp::scrollPixels(int dx, int dy)
+	{
+	const SkBitmap & bitmap = m_canvas->getDevice()->accessBitmap(true);
+	SkAutoLockPixels lock(bitmap);
+	if (bitmap.config() != SkBitmap::kARGB_8888_Config || !bitmap.getPixels())
+		return false;
+
+	int width = bitmap.width() - abs(dx);
+	int height = bitmap.height() - abs(dy);
+	if (width <= 0 || height <= 0)
+		return false;
+
+	size_t rowBytes = bitmap.rowBytes();
+	char *pPixels = static_cast<char*>(bitmap.getPixels());
+	int sourceX = dx < 0 ? -dx : 0;
+	int destX = dx > 0 ? dx : 0;
+	size_t copyBytes = static_cast<size_t>(width) * 4;
+
+	// Walk the rows against the direction of the move, so that no source row is
+	// overwritten before it has been copied. Within a row memmove handles the overlap.
+	if (dy > 0)
+		{
+		for (int y = height - 1; y >= 0; --y)
+			memmove(pPixels + (y + dy) * rowBytes + destX * 4, pPixels + y * rowBytes + sourceX * 4, copyBytes);
+		}
+	else
+		{
+		for (int y = 0; y < height; ++y)
+			memmove(pPixels + y * rowBytes + destX * 4, pPixels + (y - dy) * rowBytes + sourceX * 4, copyBytes);
+		}
+
+	bitmap.notifyPixelsChanged();
+	return true;
+	}
+
+SkIRect ViewportBackingStoreFymp::fixedObjectBounds(WebCore::FrameView *pView) const
+	{
+	SkIRect bounds;
+	bounds.setEmpty();
+
+	// Fixed position boxes always have the RenderView as containing block.
+	WebCore::RenderView *pRenderView = pView->frame()->contentRenderer();
+	if (!pRenderView || !pRenderView->positionedObjects())
+		return bounds;
+
+	WebCore::RenderBlock::PositionedObjectsListHashSet::const_iterator end = pRenderView->positionedObjects()->end();
+	for (WebCore::RenderBlock::PositionedObjectsListHashSet::const_iterator it = pRenderView->positionedObjects()->begin(); it != end; ++it)
+		{
+		WebCore::RenderBox *pBox = *it;
+		if (pBox->style()->position() != WebCore::FixedPosition)
+			continue;
+		WebCore::IntRect rect = pBox->absoluteClippedOverflowRect();
+		SkIRect boxBounds;
+		boxBounds.set(rect.x(), rect.y(), rect.right(), rect.bottom());
+		bounds.join(boxBounds);
+		}
+	return bounds;
+	}
+
+void ViewportBackingStoreFymp::paintRect(WebCore::FrameView *pView, const SkIRect & rect, SkColor backgroundColor)
+	{
+	WebCore::IntRect dirtyRect(rect.fLeft, rect.fTop, rect.width(), rect.height());
+
+	WebCore::GraphicsContext & context = *m_context;
+	context.save();
+	context.translate(-m_viewport.fLeft, -m_viewport.fTop);
+	context.clip(dirtyRect);
+	context.fillRect(dirtyRect, WebCore::Color(backgroundColor), WebCore::DeviceColorSpace);
+	pView->paint(&context, dirtyRect);
+	context.restore();
+
+	m_statistics.repaintedPixels += area(rect);
+	}
+
+void ViewportBackingStoreFymp::paint(skia::PlatformCanvas *pTarget, const SkIRect & viewport, SkColor backgroundColor)
+	{
+	WebCore::Page *pPage = m_pView->page();
+	if (!pPage || !pPage->mainFrame() || !pPage->mainFrame()->view() || viewport.isEmpty())
+		return;
+
+	double startTime = WTF::currentTime();
+	++m_statistics.frames;
+
+	m_pView->ensureLayout();
+	WebCore::FrameView *pView = pPage->mainFrame()->view();
+
+	if (!m_canvas || viewport.width() != m_viewport.width() || viewport.height() != m_viewport.height())
+		{
+		if (!resize(viewport.width(), viewport.height()))
+			return;
+		}
+
+	SkIRect fixedBounds = fixedObjectBounds(pView);
+
+	int dx = m_viewport.fLeft - viewport.fLeft;
+	int dy = m_viewport.fTop - viewport.fTop;
+	if (m_bValid && (dx || dy))
+		{
+		SkIRect retained = m_viewport;
+		if (retained.intersect(viewport) && scrollPixels(dx, dy))
+			{
+			++m_statistics.scrollFrames;
+			m_statistics.scrolledPixels += area(retained);
+
+			// Everything that was not in the old viewport has to be painted.
+			SkRegion exposed(viewport);
+			exposed.op(retained, SkRegion::kDifference_Op);
+			for (SkRegion::Iterator it(exposed); !it.done(); it.next())
+				m_dirty.add(it.rect());
+
+			// Fixed position objects may have been moved to follow the viewport; repaint
+			// them where they were and where they are now.
+			m_dirty.add(m_fixedBounds);
+			m_dirty.add(fixedBounds);
+			}
+		else
+			m_bValid = false;
+		}
+	m_viewport = viewport;
+	m_fixedBounds = fixedBounds;
+
+	if (!m_bValid)
+		{
+		++m_statistics.fullRepaints;
+		m_dirty.add(viewport);
+		m_bValid = true;
+		}
+
+	Vector<SkIRect> dirtyRects;
+	m_dirty.take(dirtyRects);
+	for (size_t i = 0; i < dirtyRects.size(); ++i)
+		{
+		SkIRect rect = dirtyRects[i];
+		if (rect.intersect(viewport))
+			paintRect(pView, rect, backgroundColor);
+		}
+
+	pTarget->drawBitmap(m_canvas->getDevice()->accessBitmap(false), 0, 0);
+
+	m_statistics.paintSeconds += WTF::currentTime() - startTime;
+	}
+
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ViewportBackingStoreFymp_h
+#define ViewportBackingStoreFymp_h
+
+#include "DamageAccumulatorFymp.h"
+#include "WebViewFymp.h"
+
+#include "SkRegion.h"
+
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+
+namespace WebCore {
+	class FrameView;
+	class GraphicsContext;
+}
+
+namespace WebKit {
+
+/*
+	Retained copy of the visible part of the main frame.
+
+	The main FrameView is as big as the content and never scrolls itself; the host moves
+	a viewport across it. Without a retained copy every viewport move repaints the whole
+	visible area. The backing store keeps the last painted viewport, shifts its pixels by
+	the scroll delta and only paints the strip that became visible plus whatever WebCore
+	invalidated in the meantime (collected through WebViewFympListener::needRepaint, in
+	content coordinates and merged into a few rects by DamageAccumulatorFymp).
+
+	Fixed position objects are repainted at their old and new place whenever the viewport
+	moves, so they come out right no matter whether the host keeps them in place or not.
+	Composited layers are not part of the root layer's painting, the compositor draws them
+	on top of the backing store.
+*/
+class ViewportBackingStoreFymp : public WebViewFympListener, public Noncopyable
+	{
+public:
+	ViewportBackingStoreFymp(WebViewFymp *pView);
+	virtual ~ViewportBackingStoreFymp();
+
+	// WebViewFympListener
+	virtual void needRepaint(SkIRect & rect);
+
+	// Brings the backing store up to date for the given viewport (content coordinates)
+	// and draws it to the target canvas at its origin.
+	void paint(skia::PlatformCanvas *pTarget, const SkIRect & viewport, SkColor backgroundColor);
+
+	const ViewportBackingStatistics & statistics() const { return m_statistics; }
+
+private:
+	bool resize(int width, int height);
+	bool scrollPixels(int dx, int dy);
+	SkIRect fixedObjectBounds(WebCore::FrameView *pView) const;
+	void paintRect(WebCore::FrameView *pView, const SkIRect & rect, SkColor backgroundColor);
+
+	WebViewFymp *								m_pView;
+
+	OwnPtr<skia::PlatformCanvas>				m_canvas;
+	OwnPtr<PlatformContextSkia>					m_platformContext;
+	OwnPtr<WebCore::GraphicsContext>			m_context;
+
+	SkIRect										m_viewport;			//!< content area currently held by the backing store
+	bool										m_bValid;			//!< false until the first full paint
+	DamageAccumulatorFymp						m_dirty;			//!< content coordinates
+	SkIRect										m_fixedBounds;		//!< fixed position objects at the last paint
+
+	ViewportBackingStatistics					m_statistics;
+	};
+
+}
+
+#endif
@@ -18,6 +18,8 @@ typedef class PlatformContextSkia PlatformGraphicsContext;
 
 #include "ChromeClient.h"
 
+#include <JavaScriptCore/JSBase.h>
+
 extern "C" {
 typedef struct NPObject NPObject;
 typedef struct _NPVariant NPVariant;
@@ -131,6 +133,117 @@ struct HeapStatistics
 	size_t countObjects;
 	};
 
+struct RenderArenaStatistics
+	{
+	RenderArenaStatistics() : committedBytes(0), liveBytes(0), recycledBytes(0), wastedBytes(0), documentCount(0) {}
+
+	size_t committedBytes;		//!< arena memory taken from the system
+	size_t liveBytes;			//!< memory backing live render objects
+	size_t recycledBytes;		//!< freed objects waiting for reuse (fragmentation)
+	size_t wastedBytes;			//!< committed, but not backing a live object
+	unsigned documentCount;
+	};
+
+struct ViewportBackingStatistics
+	{
+	ViewportBackingStatistics() : frames(0), scrollFrames(0), fullRepaints(0), scrolledPixels(0), repaintedPixels(0), paintSeconds(0) {}
+
+	unsigned frames;			//!< paintViewport() calls
+	unsigned scrollFrames;		//!< frames that moved the viewport and reused the retained pixels
+	unsigned fullRepaints;		//!< frames that had to paint the whole viewport
+	u64 scrolledPixels;			//!< pixels moved instead of painted
+	u64 repaintedPixels;		//!< pixels painted by WebCore
+	double paintSeconds;		//!< total time spent in paintViewport()
+	};
+
+struct DamageStatistics
+	{
+	DamageStatistics() : frames(0), reportedRects(0), damageRects(0), reportedPixels(0), damagePixels(0), occludedPixels(0) {}
+
+	unsigned frames;			//!< takeDamage() calls
+	unsigned reportedRects;		//!< rects invalidated by WebCore
+	unsigned damageRects;		//!< rects handed out by takeDamage() after merging
+	u64 reportedPixels;			//!< area of the invalidated rects, overlaps counted repeatedly
+	u64 damagePixels;			//!< area of the rects handed out
+	u64 occludedPixels;			//!< area held back because opaque layers covered it
+	};
+
+struct CompositingMemoryStatistics
+	{
+	CompositingMemoryStatistics() : budget(0), textureBytes(0), pooledBytes(0), poolHits(0), poolMisses(0), layers(0), demotedLayers(0) {}
+
+	size_t budget;				//!< 0 when unlimited
+	size_t textureBytes;		//!< pixels held by layer textures
+	size_t pooledBytes;			//!< released texture pixels kept for reuse
+	unsigned poolHits;			//!< textures that got their pixels from the pool
+	unsigned poolMisses;		//!< textures that had to allocate
+	unsigned layers;			//!< composited layers with content of their own
+	unsigned demotedLayers;		//!< of those, painted without a texture to stay within the budget
+	};
+
+struct EnumerationCacheStatistics
+	{
+	EnumerationCacheStatistics() : hits(0), dictionaryHits(0), misses(0), indexed(0) {}
+
+	unsigned hits;				//!< for-in loops that reused the property names of an earlier loop
+	unsigned dictionaryHits;	//!< of those, over objects in dictionary mode
+	unsigned misses;			//!< for-in loops that had to collect the property names
+	unsigned indexed;			//!< of those, over array indices without making the names up front
+	};
+
+struct ScopeAllocationStatistics
+	{
+	ScopeAllocationStatistics() : activations(0), arguments(0), argumentReads(0) {}
+
+	unsigned activations;		//!< function calls that created an activation (for closures, eval, with or catch)
+	unsigned arguments;			//!< arguments objects created
+	unsigned argumentReads;		//!< arguments.length and arguments[i] read without creating the object
+	};
+
+struct ScriptStackStatistics
+	{
+	ScriptStackStatistics() : reservedBytes(0), committedBytes(0), highWaterBytes(0), overflows(0) {}
+
+	size_t reservedBytes;		//!< register file capacity; allocated up front where memory can't be committed on demand
+	size_t committedBytes;		//!< of those, backed by memory
+	size_t highWaterBytes;		//!< deepest use by call frames since startup
+	unsigned overflows;			//!< stack overflow errors because the register file was full
+	};
+
+struct SpatialNavigationStatistics
+	{
+	SpatialNavigationStatistics() : moves(0), indexRebuilds(0), fallbacks(0), candidatesChecked(0) {}
+
+	unsigned moves;				//!< arrow key moves answered from the focusable element index
+	unsigned indexRebuilds;		//!< indices built again after focusable elements changed, a layout or a box scroll
+	unsigned fallbacks;			//!< moves that walked the whole document (frames, scrollable boxes)
+	unsigned candidatesChecked;	//!< elements whose distance to the focused one was computed
+	};
+
+typedef u32 ScriptHandleFymp;
+
+// Argument of a queued script message, see WebViewFymp::postScriptMessage().
+struct ScriptArgumentFymp
+	{
+	enum Type { Undefined, Number, Boolean, String };
+
+	ScriptArgumentFymp() : type(Undefined), number(0), pString(0) {}
+	ScriptArgumentFymp(double value) : type(Number), number(value), pString(0) {}
+	ScriptArgumentFymp(int value) : type(Number), number(value), pString(0) {}
+	ScriptArgumentFymp(bool value) : type(Boolean), number(value ? 1 : 0), pString(0) {}
+	ScriptArgumentFymp(const char *pValue) : type(String), number(0), pString(pValue) {}
+
+	Type type;
+	double number;				//!< Number, and Boolean as 0 or 1
+	const char *pString;		//!< String, UTF-8; copied when the message is posted
+	};
+
+// Receives the return value (or the thrown exception) of a script message. The value is
+// only valid during the callback; read it with the C API or NativeBindingFymp. A message
+// that was dropped, because its handle went stale or was unregistered or the view has no
+// script queue, gets ctx and result 0 and bException false.
+typedef void (*ScriptResultCallbackFymp)(void *pContext, JSContextRef ctx, JSValueRef result, bool bException);
+
 struct FYMP_PRXSYM_WEBKIT WebViewConfig
 {
 	WebViewConfig();
@@ -184,6 +297,34 @@ public:
     void addToJavaScriptWindowObject(WebCore::Frame*, const char *, NPObject*);
     NPVariant evaluateJavaScript(WebCore::Frame*, const char *);
 
+	// Native bindings on the JavaScriptCore C API, for chatty host services. Objects of a
+	// JSClassRef (see NativeBindingFymp) are called without the NPObject bridge and its
+	// NPVariant conversions. Like addToJavaScriptWindowObject(), objects have to be added
+	// again after every WindowClear event.
+	JSGlobalContextRef getJavaScriptContext(WebCore::Frame *pFrame);
+	JSObjectRef addNativeObject(WebCore::Frame *pFrame, const char *pName, JSClassRef objectClass, void *pPrivate);
+
+	// Adds window.fympBindingBenchmark and window.fympNPBindingBenchmark, the same functions
+	// through both paths, for WebCore/benchmarks/bindings/native-calls.html.
+	void addBindingBenchmarkObjects(WebCore::Frame *pFrame);
+
+	// Adds window.fympScopeAllocations(), which returns getScopeAllocationStatistics() as an
+	// object, for WebCore/benchmarks/js/closures-arguments.html.
+	void addScopeAllocationFunction(WebCore::Frame *pFrame);
+
+	// Precompiled scripts and batched host to JS messages. registerScript() compiles a
+	// function expression, e.g. "function(x, y) { player.moveTo(x, y); }", once and returns
+	// a handle for it (0 if it doesn't compile). postScriptMessage() queues a call of it;
+	// deliverScriptMessages(), called once per display frame, runs everything queued with
+	// a single JS entry per frame, in posting order. Handles go stale when their frame
+	// navigates (WindowClear); messages for them are dropped. The host has to call
+	// releaseExtensions() (or unregisterAllScripts()) before it destroys the view.
+	ScriptHandleFymp registerScript(WebCore::Frame *pFrame, const char *pFunctionSource);
+	void unregisterScript(ScriptHandleFymp handle);
+	void unregisterAllScripts();
+	void postScriptMessage(ScriptHandleFymp handle, const ScriptArgumentFymp *pArguments, u32 argumentCount, ScriptResultCallbackFymp callback = 0, void *pContext = 0);
+	u32 deliverScriptMessages();
+
     static AccessFilter *getRequestFilter() { return s_config.m_requestFilter; }
     void disableWebSecurity();
 
@@ -191,6 +332,7 @@ public:
     void collectJavascriptGarbageSoon();
 
 	HeapStatistics getHeapStatistics() const;
+	RenderArenaStatistics getRenderArenaStatistics() const;
 
 	WebCore::Page * page() { return m_page; }
 
@@ -202,6 +344,91 @@ public:
 
 	void ensureLayout();
 
+	// Drops the viewport backing, damage accumulation and script queue of this view. The
+	// host has to call it before it destroys the view; their entries are kept by view
+	// address and would otherwise leak and be picked up by the next view at that address.
+	void releaseExtensions();
+
+	// Persistent glyph page / advance width cache for the bundled system fonts.
+	// The host memory-maps the image written by serializeGlyphCache() on a previous
+	// launch; fontSetHash must be a hash over the bundled font files and invalidates
+	// the image whenever the fonts change.
+	static bool setGlyphCacheData(const void *pData, unsigned size, unsigned fontSetHash);
+	static void setGlyphCacheRecording(bool bRecording);
+	static void serializeGlyphCache(std::vector<char> & image);
+
+	// Pre-blurred box shadow bitmaps are kept in a cache of this many bytes (2 MB by
+	// default); least recently used shadows are dropped first. 0 disables the cache.
+	static void setShadowCacheBudget(u32 bytes);
+
+	// Rendered form control parts (buttons, menu lists, slider thumbs) are kept in a cache
+	// of this many bytes (512 KB by default). 0 disables the cache.
+	static void setThemeCacheBudget(u32 bytes);
+
+	// Antialiased coverage of small paths drawn repeatedly (SVG and canvas icons) is kept
+	// in a cache of this many bytes (1 MB by default). 0 disables the cache.
+	static void setPathCacheBudget(u32 bytes);
+
+	// Limits the pixels held by composited layer textures. Over budget, the largest layers
+	// that haven't moved within the last second drop their textures and are painted
+	// directly on every composite until there is room again. 0 (the default) means
+	// unlimited. Released texture pixels are pooled for reuse, up to poolBytes (4 MB by
+	// default), on top of the budget.
+	static void setCompositingMemoryBudget(u32 bytes, u32 poolBytes = 4 * 1024 * 1024);
+	static CompositingMemoryStatistics getCompositingMemoryStatistics();
+
+	// Counted since startup for all pages; compare two readings to get the hit rate of a frame.
+	static EnumerationCacheStatistics getEnumerationCacheStatistics();
+	static ScopeAllocationStatistics getScopeAllocationStatistics();
+
+	// Hard limits of the JS stack shared by all pages. The register file holds the call
+	// frames (4 MB by default, in 64 KB steps); without virtual memory it is allocated in
+	// full when the first page runs script, so set the limits before loading anything.
+	// maxNestedCalls limits calls from native code back into JS, e.g. forEach callbacks,
+	// accessors or event handlers, which take native stack (256 by default, at least 32).
+	// Stack overflow errors that don't show up in ScriptStackStatistics::overflows come
+	// from maxNestedCalls.
+	static void setScriptStackLimits(u32 registerFileBytes, u32 maxNestedCalls);
+	static ScriptStackStatistics getScriptStackStatistics();
+
+	// Shadows are blurred with WebCore's three pass box blur. Turning this off falls
+	// back to Skia's SkBlurDrawLooper, e.g. to compare both in benchmarks.
+	static void setBoxBlurShadows(bool bEnabled);
+
+	// Frame clock for CSS animations and transitions. Once enabled, animations are no
+	// longer ticked by an internal 40 Hz timer; the host calls serviceAnimations() once
+	// per display frame while the view is shown. Idle calls are cheap, the result tells
+	// whether any animation is running.
+	void setAnimationFrameClock(bool bEnabled);
+	bool serviceAnimations();
+
+	// Retained viewport backing store. While enabled, paintViewport() keeps a copy of the
+	// last painted viewport (content coordinates) and on scrolling only paints the newly
+	// exposed area and what was invalidated since. The host has to disable it, or call
+	// releaseExtensions(), before it destroys the view.
+	void setViewportBacking(bool bEnabled);
+	void paintViewport(skia::PlatformCanvas *pTarget, const SkIRect & viewport);
+	ViewportBackingStatistics getViewportBackingStatistics() const;
+
+	// Per frame damage accumulation. While enabled, invalidations are merged into at most
+	// maxRects rects; takeDamage() returns them once per frame, leaving out areas covered
+	// by opaque composited layers. needRepaint() listeners are still called as before.
+	// The host has to disable it, or call releaseExtensions(), before it destroys the view.
+	void setDamageAccumulation(bool bEnabled, u32 maxRects = 16);
+	void takeDamage(std::vector<SkIRect> & rects);
+	DamageStatistics getDamageStatistics() const;
+
+	// Debug overlay tinting areas where painting was skipped because an opaque layer
+	// covers them.
+	void setOccludedPaintingOverlay(bool bEnabled);
+
+	// Moves the focus with the arrow keys to the nearest focusable element in that
+	// direction. Elements are looked up in a per document index of their positions, which
+	// is built again after nodes are added or removed, their focusability changes, layouts
+	// and scrolled boxes.
+	void setSpatialNavigation(bool bEnabled);
+	static SpatialNavigationStatistics getSpatialNavigationStatistics();
+
 protected:
     virtual void onDraw(SkCanvas*);
 
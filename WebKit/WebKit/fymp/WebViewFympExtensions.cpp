@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2014 FactorY Media Production GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FACTORY MEDIA PRODUCTION GMBH AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL FACTORY MEDIA PRODUCTION GMBH OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// WebViewFymp extension API that is implemented on the WebCore side.
+
+#include "config.h"
+#include "WebViewFymp.h"
+
+#include "AnimationController.h"
+#include "BoxBlurSkia.h"
+#include "DamageAccumulatorFymp.h"
+#include "Document.h"
+#include "Frame.h"
+#include "FrameTree.h"
+#include "FrameView.h"
+#include "GlyphCacheFymp.h"
+#include "JSDOMWindowBase.h"
+#include "NativeBindingFymp.h"
+#include "npruntime.h"
+#include "Page.h"
+#include "PathCacheSkia.h"
+#include "RenderArena.h"
+#include "ScriptController.h"
+#include "ScriptQueueFymp.h"
+#include "Settings.h"
+#include "ShadowCacheSkia.h"
+#include "SpatialNavigationIndexFymp.h"
+#include "texmap/TextureMapper.h"
+#include "ThemePartCacheFymp.h"
+#include "ViewportBackingStoreFymp.h"
+
+#include <JavaScriptCore/APICast.h>
+#include <interpreter/Interpreter.h>
+#include <runtime/JSActivation.h>
+#include <runtime/JSGlobalData.h>
+#include <runtime/JSPropertyNameIterator.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/HashMap.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebKit {
+
+bool WebViewFymp::setGlyphCacheData(const void *pData, unsigned size, unsigned fontSetHash)
+	{
+	return WebCore::GlyphCacheFymp::shared().setMappedData(pData, size, fontSetHash);
+	}
+
+void WebViewFymp::setGlyphCacheRecording(bool bRecording)
+	{
+	WebCore::GlyphCacheFymp::shared().setRecording(bRecording);
+	}
+
+void WebViewFymp::serializeGlyphCache(std::vector<char> & image)
+	{
+	Vector<char> data;
+	WebCore::GlyphCacheFymp::shared().serialize(data);
+	image.assign(data.begin(), data.end());
+	}
+
+void WebViewFymp::setShadowCacheBudget(u32 bytes)
+	{
+	WebCore::ShadowCacheSkia::shared().setBudget(bytes);
+	}
+
+void WebViewFymp::setThemeCacheBudget(u32 bytes)
+	{
+	WebCore::ThemePartCacheFymp::shared().setBudget(bytes);
+	}
+
+void WebViewFymp::setPathCacheBudget(u32 bytes)
+	{
+	WebCore::PathCacheSkia::shared().setBudget(bytes);
+	}
+
+void WebViewFymp::setCompositingMemoryBudget(u32 bytes, u32 poolBytes)
+	{
+	WebCore::setCompositingMemoryBudget(bytes);
+	WebCore::setTexturePoolLimit(poolBytes);
+	}
+
+CompositingMemoryStatistics WebViewFymp::getCompositingMemoryStatistics()
+	{
+	WebCore::TextureMapperMemoryStatistics statistics;
+	WebCore::getCompositingMemoryStatistics(statistics);
+
+	CompositingMemoryStatistics result;
+	result.budget = statistics.budget;
+	result.textureBytes = statistics.allocatedBytes;
+	result.pooledBytes = statistics.pooledBytes;
+	result.poolHits = statistics.poolHits;
+	result.poolMisses = statistics.poolMisses;
+	result.layers = statistics.layers;
+	result.demotedLayers = statistics.demotedLayers;
+	return result;
+	}
+
+EnumerationCacheStatistics WebViewFymp::getEnumerationCacheStatistics()
+	{
+	const JSC::EnumerationCacheStatistics & statistics = JSC::JSPropertyNameIterator::statistics();
+
+	EnumerationCacheStatistics result;
+	result.hits = statistics.hits;
+	result.dictionaryHits = statistics.dictionaryHits;
+	result.misses = statistics.misses;
+	result.indexed = statistics.indexed;
+	return result;
+	}
+
+ScopeAllocationStatistics WebViewFymp::getScopeAllocationStatistics()
+	{
+	const JSC::ScopeAllocationStatistics & statistics = JSC::JSActivation::allocationStatistics();
+
+	ScopeAllocationStatistics result;
+	result.activations = statistics.activations;
+	result.arguments = statistics.arguments;
+	result.argumentReads = statistics.argumentReads;
+	return result;
+	}
+
+void WebViewFymp::setScriptStackLimits(u32 registerFileBytes, u32 maxNestedCalls)
+	{
+	JSC::JSGlobalData::StackLimits limits;
+	limits.registerFileCapacity = registerFileBytes / sizeof(JSC::Register);
+	limits.maxReentryDepth = maxNestedCalls;
+	JSC::JSGlobalData::setDefaultStackLimits(JSC::ThreadStackTypeLarge, limits);
+	}
+
+ScriptStackStatistics WebViewFymp::getScriptStackStatistics()
+	{
+	JSC::RegisterFileStatistics statistics = WebCore::JSDOMWindowBase::commonJSGlobalData()->interpreter->registerFile().statistics();
+
+	ScriptStackStatistics result;
+	result.reservedBytes = statistics.reservedBytes;
+	result.committedBytes = statistics.committedBytes;
+	result.highWaterBytes = statistics.highWaterBytes;
+	result.overflows = statistics.overflows;
+	return result;
+	}
+
+void WebViewFymp::setBoxBlurShadows(bool bEnabled)
+	{
+	if (WebCore::boxBlurShadowsEnabled() == bEnabled)
+		return;
+	WebCore::setBoxBlurShadowsEnabled(bEnabled);
+	// Cached shadows were blurred with the other implementation.
+	WebCore::ShadowCacheSkia::shared().clear();
+	}
+
+RenderArenaStatistics WebViewFymp::getRenderArenaStatistics() const
+	{
+	RenderArenaStatistics result;
+	if (!m_page)
+		return result;
+
+	for (WebCore::Frame* frame = m_page->mainFrame(); frame; frame = frame->tree()->traverseNext())
+		{
+		WebCore::Document* document = frame->document();
+		if (!document || !document->renderArena())
+			continue;
+
+		WebCore::RenderArena::Statistics statistics = document->renderArena()->statistics();
+		result.committedBytes += statistics.committedBytes;
+		result.liveBytes += statistics.liveBytes;
+		result.recycledBytes += statistics.recycledBytes;
+		result.wastedBytes += statistics.wastedBytes();
+		++result.documentCount;
+		}
+	return result;
+	}
+
+void WebViewFymp::setAnimationFrameClock(bool bEnabled)
+	{
+	if (!m_page || m_page->settings()->animationFrameClockEnabled() == bEnabled)
+		return;
+
+	m_page->settings()->setAnimationFrameClockEnabled(bEnabled);
+
+	// A last service moves animations that are waiting for a frame back onto their timers.
+	if (!bEnabled)
+		serviceAnimations();
+	}
+
+bool WebViewFymp::serviceAnimations()
+	{
+	if (!m_page)
+		return false;
+
+	// One timestamp for all frames, so that everything on screen animates in step.
+	double frameTime = WTF::currentTime();
+	bool bNeedsFrame = false;
+	for (WebCore::Frame* frame = m_page->mainFrame(); frame; frame = frame->tree()->traverseNext())
+		{
+		if (!frame->view() || !frame->contentRenderer())
+			continue;
+
+		WebCore::AnimationController* animation = frame->animation();
+		animation->serviceAnimations(frameTime);
+		bNeedsFrame |= animation->needsAnimationFrame();
+		}
+	return bNeedsFrame;
+	}
+
+// Views can't carry the backing store as a member, it lives in a side table instead.
+typedef HashMap<const WebViewFymp*, ViewportBackingStoreFymp*> ViewportBackingMap;
+
+static ViewportBackingMap & viewportBackings()
+	{
+	DEFINE_STATIC_LOCAL(ViewportBackingMap, backings, ());
+	return backings;
+	}
+
+void WebViewFymp::setViewportBacking(bool bEnabled)
+	{
+	ViewportBackingMap & backings = viewportBackings();
+	if (bEnabled == backings.contains(this))
+		return;
+
+	if (bEnabled)
+		backings.set(this, new ViewportBackingStoreFymp(this));
+	else
+		delete backings.take(this);
+	}
+
+void WebViewFymp::paintViewport(skia::PlatformCanvas *pTarget, const SkIRect & viewport)
+	{
+	ViewportBackingStoreFymp *pBacking = viewportBackings().get(this);
+	if (!pBacking)
+		{
+		repaint(pTarget, viewport);
+		return;
+		}
+	pBacking->paint(pTarget, viewport, m_baseBgColor);
+	}
+
+ViewportBackingStatistics WebViewFymp::getViewportBackingStatistics() const
+	{
+	ViewportBackingStoreFymp *pBacking = viewportBackings().get(this);
+	return pBacking ? pBacking->statistics() : ViewportBackingStatistics();
+	}
+
+// Feeds the invalidations of one view into its damage accumulator.
+class DamageListener : public WebViewFympListener
+	{
+public:
+	DamageListener(WebViewFymp *pView, unsigned maxRects) : m_pView(pView), m_accumulator(maxRects) { m_pView->addListener(this); }
+	virtual ~DamageListener() { m_pView->removeListener(this); }
+
+	virtual void needRepaint(SkIRect & rect) { m_accumulator.add(rect); }
+
+	DamageAccumulatorFymp & accumulator() { return m_accumulator; }
+
+private:
+	WebViewFymp *			m_pView;
+	DamageAccumulatorFymp	m_accumulator;
+	};
+
+typedef HashMap<const WebViewFymp*, DamageListener*> DamageListenerMap;
+
+static DamageListenerMap & damageListeners()
+	{
+	DEFINE_STATIC_LOCAL(DamageListenerMap, listeners, ());
+	return listeners;
+	}
+
+void WebViewFymp::setDamageAccumulation(bool bEnabled, u32 maxRects)
+	{
+	DamageListenerMap & listeners = damageListeners();
+	DamageListener *pListener = listeners.get(this);
+	if (!bEnabled)
+		{
+		delete listeners.take(this);
+		return;
+		}
+
+	if (pListener)
+		pListener->accumulator().setMaxRects(maxRects);
+	else
+		listeners.set(this, new DamageListener(this, maxRects));
+	}
+
+void WebViewFymp::takeDamage(std::vector<SkIRect> & rects)
+	{
+	rects.clear();
+	DamageListener *pListener = damageListeners().get(this);
+	if (!pListener)
+		return;
+
+	Vector<SkIRect> occluders;
+	if (m_page)
+		DamageAccumulatorFymp::collectOpaqueLayerRects(m_page->mainFrame(), occluders);
+
+	Vector<SkIRect> damage;
+	pListener->accumulator().setOccluders(occluders);
+	pListener->accumulator().take(damage);
+	rects.assign(damage.begin(), damage.end());
+	}
+
+DamageStatistics WebViewFymp::getDamageStatistics() const
+	{
+	DamageListener *pListener = damageListeners().get(this);
+	return pListener ? pListener->accumulator().statistics() : DamageStatistics();
+	}
+
+void WebViewFymp::setOccludedPaintingOverlay(bool bEnabled)
+	{
+	if (!m_page || m_page->settings()->showOccludedPaintingOverlay() == bEnabled)
+		return;
+
+	m_page->settings()->setShowOccludedPaintingOverlay(bEnabled);
+	if (m_page->mainFrame()->view())
+		m_page->mainFrame()->view()->invalidate();
+	}
+
+void WebViewFymp::setSpatialNavigation(bool bEnabled)
+	{
+	if (m_page)
+		m_page->settings()->setSpatialNavigationEnabled(bEnabled);
+	}
+
+SpatialNavigationStatistics WebViewFymp::getSpatialNavigationStatistics()
+	{
+	const WebCore::SpatialNavigationIndexStatistics& statistics = WebCore::SpatialNavigationIndexFymp::statistics();
+
+	SpatialNavigationStatistics result;
+	result.moves = statistics.queries;
+	result.indexRebuilds = statistics.rebuilds;
+	result.fallbacks = statistics.fallbacks;
+	result.candidatesChecked = statistics.candidatesChecked;
+	return result;
+	}
+
+JSGlobalContextRef WebViewFymp::getJavaScriptContext(WebCore::Frame *pFrame)
+	{
+	if (!pFrame)
+		return 0;
+	return toGlobalRef(pFrame->script()->globalObject(WebCore::mainThreadNormalWorld())->globalExec());
+	}
+
+JSObjectRef WebViewFymp::addNativeObject(WebCore::Frame *pFrame, const char *pName, JSClassRef objectClass, void *pPrivate)
+	{
+	JSGlobalContextRef ctx = getJavaScriptContext(pFrame);
+	if (!ctx)
+		return 0;
+
+	JSObjectRef object = JSObjectMake(ctx, objectClass, pPrivate);
+	JSStringRef name = JSStringCreateWithUTF8CString(pName);
+	JSObjectSetProperty(ctx, JSContextGetGlobalObject(ctx), name, object, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete, 0);
+	JSStringRelease(name);
+	return object;
+	}
+
+void WebViewFymp::addBindingBenchmarkObjects(WebCore::Frame *pFrame)
+	{
+	JSGlobalContextRef ctx = getJavaScriptContext(pFrame);
+	if (!ctx)
+		return;
+
+	JSStringRef name = JSStringCreateWithUTF8CString("fympBindingBenchmark");
+	JSObjectSetProperty(ctx, JSContextGetGlobalObject(ctx), name, NativeBindingFymp::createBenchmarkObject(ctx), kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete, 0);
+	JSStringRelease(name);
+
+	NPObject *pObject = NativeBindingFymp::createNPBenchmarkObject();
+	addToJavaScriptWindowObject(pFrame, "fympNPBindingBenchmark", pObject);
+	NPN_ReleaseObject(pObject);
+	}
+
+static void setNumberProperty(JSContextRef ctx, JSObjectRef object, const char *pName, double value)
+	{
+	JSStringRef name = JSStringCreateWithUTF8CString(pName);
+	JSObjectSetProperty(ctx, object, name, JSValueMakeNumber(ctx, value), kJSPropertyAttributeNone, 0);
+	JSStringRelease(name);
+	}
+
+static JSValueRef scopeAllocations(JSContextRef ctx, JSObjectRef, JSObjectRef, size_t, const JSValueRef[], JSValueRef *)
+	{
+	ScopeAllocationStatistics statistics = WebViewFymp::getScopeAllocationStatistics();
+
+	JSObjectRef result = JSObjectMake(ctx, 0, 0);
+	setNumberProperty(ctx, result, "activations", statistics.activations);
+	setNumberProperty(ctx, result, "arguments", statistics.arguments);
+	setNumberProperty(ctx, result, "argumentReads", statistics.argumentReads);
+	return result;
+	}
+
+void WebViewFymp::addScopeAllocationFunction(WebCore::Frame *pFrame)
+	{
+	JSGlobalContextRef ctx = getJavaScriptContext(pFrame);
+	if (!ctx)
+		return;
+
+	JSStringRef name = JSStringCreateWithUTF8CString("fympScopeAllocations");
+	JSObjectSetProperty(ctx, JSContextGetGlobalObject(ctx), name, JSObjectMakeFunctionWithCallback(ctx, name, scopeAllocations), kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete, 0);
+	JSStringRelease(name);
+	}
+
+typedef HashMap<const WebViewFymp*, ScriptQueueFymp*> ScriptQueueMap;
+
+static ScriptQueueMap & scriptQueues()
+	{
+	DEFINE_STATIC_LOCAL(ScriptQueueMap, queues, ());
+	return queues;
+	}
+
+ScriptHandleFymp WebViewFymp::registerScript(WebCore::Frame *pFrame, const char *pFunctionSource)
+	{
+	JSGlobalContextRef ctx = getJavaScriptContext(pFrame);
+	if (!ctx || !pFunctionSource)
+		return 0;
+
+	ScriptQueueFymp *& pQueue = scriptQueues().add(this, 0).first->second;
+	if (!pQueue)
+		pQueue = new ScriptQueueFymp;
+	return pQueue->registerScript(pFrame, ctx, pFunctionSource);
+	}
+
+void WebViewFymp::unregisterScript(ScriptHandleFymp handle)
+	{
+	if (ScriptQueueFymp *pQueue = scriptQueues().get(this))
+		pQueue->unregisterScript(handle);
+	}
+
+void WebViewFymp::unregisterAllScripts()
+	{
+	// Called from a result callback, the queue goes away once it has delivered.
+	if (ScriptQueueFymp *pQueue = scriptQueues().take(this))
+		pQueue->destroy();
+	}
+
+void WebViewFymp::postScriptMessage(ScriptHandleFymp handle, const ScriptArgumentFymp *pArguments, u32 argumentCount, ScriptResultCallbackFymp callback, void *pContext)
+	{
+	ScriptQueueFymp *pQueue = scriptQueues().get(this);
+	if (!pQueue)
+		{
+		if (callback)
+			callback(pContext, 0, 0, false);
+		return;
+		}
+	pQueue->post(handle, pArguments, argumentCount, callback, pContext);
+	}
+
+u32 WebViewFymp::deliverScriptMessages()
+	{
+	ScriptQueueFymp *pQueue = scriptQueues().get(this);
+	return pQueue ? pQueue->deliver() : 0;
+	}
+
+void WebViewFymp::releaseExtensions()
+	{
+	delete viewportBackings().take(this);
+	delete damageListeners().take(this);
+	unregisterAllScripts();
+	}
+
+}